@@ -0,0 +1,55 @@
+// Numeric Array kernels against the generic (std::function/std::sort) path.
+//   clang++-20 -std=c++20 -O3 -march=native -Isrc bench/array.cpp src/core/*/*.cpp -o dist/bench-array
+
+#include "../src/core/core.hpp"
+#include "bench.hpp"
+#include <limits>
+#include <random>
+
+template <typename T> $Array<T> randomArray(const std::size_t n) {
+  std::mt19937_64 rng(42);
+  auto out = $Array<T>::make(n);
+  for (std::size_t i = 0; i < n; ++i)
+    if constexpr (std::is_floating_point_v<T>)
+      out->push(std::uniform_real_distribution<T>(-1e6, 1e6)(rng));
+    else
+      out->push(std::uniform_int_distribution<T>(-1000, 1000)(rng)); // small enough that sums can't overflow
+  return out;
+}
+
+template <typename T> void run(const char *type, const std::size_t n) {
+  auto arr = randomArray<T>(n);
+  T missing = std::numeric_limits<T>::lowest(); // not in the array, so indexOf and findIndex scan all of it
+  char name[64];
+  auto label = [&](const char *op) {
+    std::snprintf(name, sizeof name, "%s[%zu] %s", type, n, op);
+    return name;
+  };
+
+  bench(label("reduce (generic)"), 10, [&] {
+    keep(arr->reduce([](const T &a, const T &b, const std::size_t) { return static_cast<T>(a + b); }));
+  });
+  bench(label("sum"), 10, [&] { keep(arr->sum()); });
+  bench(label("reduce max (generic)"), 10, [&] {
+    keep(arr->reduce([](const T &a, const T &b, const std::size_t) { return a > b ? a : b; }));
+  });
+  bench(label("max"), 10, [&] { keep(arr->max()); });
+  bench(label("findIndex (generic)"), 10,
+        [&] { keep(arr->findIndex([&](const T &t, const std::size_t) { return t == missing; })); });
+  bench(label("indexOf"), 10, [&] { keep(arr->indexOf(missing)); });
+  bench(label("map * 2 (generic)"), 10,
+        [&] { keep(arr->template map<T>([](const T &t, const std::size_t) { return static_cast<T>(t * 2); })); });
+  bench(label("mul 2"), 10, [&] { keep(arr->mul(2)); });
+  bench(label("toSorted (comparator, std::sort)"), 1,
+        [&] { keep(arr->toSorted([](const T &a, const T &b) { return a < b; })); });
+  bench(label("toSorted (radix)"), 1, [&] { keep(arr->toSorted()); });
+}
+
+int main() {
+  constexpr std::size_t N = 1 << 20;
+  run<i32>("i32", N);
+  run<i64>("i64", N);
+  run<f32>("f32", N);
+  run<f64>("f64", N);
+  return 0;
+}
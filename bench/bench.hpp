@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Keeps the optimizer from dropping a result that is otherwise unused.
+template <typename T> inline void keep(const T &t) { asm volatile("" : : "r,m"(t) : "memory"); }
+
+// Prints the median of the samples (ns per iteration). With BENCH_JSON=<file>, the result is also appended there as a
+// JSON line with every sample, which is what bench/compare reads.
+inline void report(const char *name, std::vector<double> times) {
+  std::vector<double> sorted = times;
+  std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+  double median = sorted[sorted.size() / 2];
+  std::printf("%-44s %14.1f ns\n", name, median);
+
+  if (const char *path = std::getenv("BENCH_JSON"))
+    if (std::FILE *out = std::fopen(path, "a")) {
+      std::fprintf(out, "{\"name\":\"");
+      for (const char *c = name; *c; ++c)
+        std::fprintf(out, *c == '"' || *c == '\\' ? "\\%c" : "%c", *c);
+      std::fprintf(out, "\",\"median\":%.1f,\"samples\":[", median);
+      for (std::size_t i = 0; i < times.size(); ++i)
+        std::fprintf(out, i ? ",%.1f" : "%.1f", times[i]);
+      std::fprintf(out, "]}\n");
+      std::fclose(out);
+    }
+}
+
+// Runs f `iterations` times per sample and reports the time of one iteration over all samples.
+template <typename F> void bench(const char *name, const std::size_t iterations, F &&f, const std::size_t samples = 15) {
+  std::vector<double> times;
+  times.reserve(samples);
+  f(); // warm up
+  for (std::size_t s = 0; s < samples; ++s) {
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+      f();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    times.push_back(elapsed.count() / iterations);
+  }
+  report(name, times);
+}
+
+// For work that needs a fresh setup per sample: f does the setup, times the measured part itself and returns it.
+template <typename F> void benchTimed(const char *name, F &&f, const std::size_t samples = 15) {
+  std::vector<double> times;
+  times.reserve(samples);
+  f(); // warm up
+  for (std::size_t s = 0; s < samples; ++s)
+    times.push_back(std::chrono::duration<double, std::nano>(f()).count());
+  report(name, times);
+}
+
+// Times the part of a benchTimed sample between construction and stop().
+class Stopwatch {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+public:
+  std::chrono::steady_clock::duration stop() const { return std::chrono::steady_clock::now() - start; }
+};
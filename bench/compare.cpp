@@ -0,0 +1,121 @@
+// Compares two BENCH_JSON result files, e.g. from bench/run.sh on two commits. A benchmark only counts as changed when
+// its median moved by more than the threshold and a Mann-Whitney U test on the samples says the shift is unlikely to be
+// noise (p < 0.01). Exits with 1 if anything got slower.
+//   clang++-20 -std=c++20 -O2 bench/compare.cpp -o dist/bench-compare
+//   dist/bench-compare <baseline.jsonl> <candidate.jsonl> [threshold %, default 5]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct Result {
+  double median;
+  std::vector<double> samples;
+};
+
+// Reads the lines written by report() in bench.hpp, later lines win. Lines that don't parse, like the last one of an
+// interrupted run, are skipped.
+std::map<std::string, Result> load(const char *path) {
+  std::map<std::string, Result> results;
+  std::ifstream in(path);
+  if (!in) {
+    std::fprintf(stderr, "can't read %s\n", path);
+    std::exit(2);
+  }
+  for (std::string line; std::getline(in, line);) {
+    std::size_t i = line.find("\"name\":\""), median = line.find("\"median\":"), samples = line.find("\"samples\":[");
+    if (i == std::string::npos || median == std::string::npos || samples == std::string::npos)
+      continue;
+    std::string name;
+    for (i += 8; i < line.size() && line[i] != '"'; ++i)
+      name += line[i] == '\\' && i + 1 < line.size() ? line[++i] : line[i];
+
+    Result r;
+    r.median = std::strtod(line.c_str() + median + 9, nullptr);
+    const char *p = line.c_str() + samples + 11;
+    while (*p && *p != ']') {
+      char *end;
+      double sample = std::strtod(p, &end);
+      if (end == p) // not a number
+        break;
+      r.samples.push_back(sample);
+      p = end;
+      while (*p == ' ')
+        ++p;
+      if (*p == ',')
+        ++p;
+    }
+    if (*p != ']' || r.samples.empty()) // cut off or malformed
+      continue;
+    results[name] = std::move(r);
+  }
+  return results;
+}
+
+// two-sided p-value of the Mann-Whitney U test, normal approximation with average ranks for ties
+double mannWhitney(const std::vector<double> &a, const std::vector<double> &b) {
+  std::vector<std::pair<double, bool>> all;
+  for (double x : a)
+    all.emplace_back(x, true);
+  for (double x : b)
+    all.emplace_back(x, false);
+  std::sort(all.begin(), all.end());
+
+  double rankA = 0;
+  for (std::size_t i = 0; i < all.size();) {
+    std::size_t j = i;
+    while (j < all.size() && all[j].first == all[i].first)
+      ++j;
+    double rank = (i + j + 1) / 2.0; // ranks i+1 to j share their mean
+    for (std::size_t k = i; k < j; ++k)
+      if (all[k].second)
+        rankA += rank;
+    i = j;
+  }
+
+  double n1 = a.size(), n2 = b.size();
+  double u = rankA - n1 * (n1 + 1) / 2;
+  double sigma = std::sqrt(n1 * n2 * (n1 + n2 + 1) / 12);
+  if (sigma == 0)
+    return 1;
+  return std::erfc(std::abs(u - n1 * n2 / 2) / sigma / std::sqrt(2.0));
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 3) {
+    std::fprintf(stderr, "usage: %s <baseline.jsonl> <candidate.jsonl> [threshold %%]\n", argv[0]);
+    return 2;
+  }
+  double threshold = argc > 3 ? std::strtod(argv[3], nullptr) : 5;
+  auto baseline = load(argv[1]), candidate = load(argv[2]);
+
+  int slower = 0, faster = 0;
+  std::printf("%-44s %14s %14s %8s %8s\n", "benchmark", "baseline", "candidate", "change", "p");
+  for (auto &[name, c] : candidate) {
+    auto it = baseline.find(name);
+    if (it == baseline.end()) {
+      std::printf("%-44s %14s %14.1f %8s\n", name.c_str(), "-", c.median, "new");
+      continue;
+    }
+    const Result &b = it->second;
+    double change = (c.median / b.median - 1) * 100, p = mannWhitney(b.samples, c.samples);
+    const char *verdict = "";
+    if (p < 0.01 && std::abs(change) > threshold) {
+      verdict = change > 0 ? "  slower" : "  faster";
+      ++(change > 0 ? slower : faster);
+    }
+    std::printf("%-44s %14.1f %14.1f %+7.1f%% %8.3f%s\n", name.c_str(), b.median, c.median, change, p, verdict);
+  }
+  for (auto &[name, b] : baseline)
+    if (!candidate.count(name))
+      std::printf("%-44s %14.1f %14s %8s\n", name.c_str(), b.median, "-", "gone");
+
+  std::printf("%d slower, %d faster (threshold %.1f%%)\n", slower, faster, threshold);
+  return slower > 0;
+}
@@ -0,0 +1,28 @@
+// Wall time of whole commands, like compiled .tn programs or the compiler transpiling itself, with the same sampling
+// and output as the microbenchmarks. bench/run.sh drives it.
+//   clang++-20 -std=c++20 -O2 bench/e2e.cpp -o dist/bench-e2e
+//   dist/bench-e2e <samples> <name> <command> [<name> <command>]...
+
+#include "bench.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+int main(int argc, char *argv[]) {
+  if (argc < 4 || argc % 2) {
+    std::fprintf(stderr, "usage: %s <samples> <name> <command> [<name> <command>]...\n", argv[0]);
+    return 1;
+  }
+  std::size_t samples = std::strtoul(argv[1], nullptr, 10);
+  int failed = 0;
+  for (int i = 2; i < argc; i += 2) {
+    std::string command = std::string(argv[i + 1]) + " > /dev/null";
+    if (std::system(command.c_str()) != 0) { // don't time a broken command
+      std::fprintf(stderr, "%s failed: %s\n", argv[i], argv[i + 1]);
+      failed = 1;
+      continue;
+    }
+    bench(argv[i], 1, [&] { keep(std::system(command.c_str())); }, samples);
+  }
+  return failed;
+}
@@ -0,0 +1,42 @@
+#!/bin/sh
+# Builds and runs every benchmark: the runtime microbenchmarks, the .tn programs in bench/ and the compiler transpiling
+# its own sources. Results go to bench/results/<commit>.jsonl (or the given file), compare two runs with
+#   dist/bench-compare bench/results/<before>.jsonl bench/results/<after>.jsonl
+# TNC is the compiler used for the .tn programs and the transpile timings (default dist/compiler), SAMPLES the number
+# of runs per program (default 10).
+#   bench/run.sh [results.jsonl]
+set -e
+cd "$(dirname "$0")/.."
+ROOT=$(pwd)
+RESULTS=$(realpath -m "${1:-bench/results/$(git rev-parse --short HEAD).jsonl}")
+TNC=$(realpath "${TNC:-dist/compiler}")
+SAMPLES=${SAMPLES:-10}
+
+mkdir -p dist "$(dirname "$RESULTS")"
+rm -f "$RESULTS"
+export BENCH_JSON="$RESULTS"
+
+FLAGS="-std=c++20 -O3 -march=native -DNDEBUG -Isrc"
+clang++-20 $FLAGS bench/array.cpp src/core/*/*.cpp -o dist/bench-array
+clang++-20 $FLAGS bench/runtime.cpp src/core/*/*.cpp -o dist/bench-runtime
+clang++-20 -std=c++20 -O2 bench/e2e.cpp -o dist/bench-e2e
+clang++-20 -std=c++20 -O2 bench/compare.cpp -o dist/bench-compare
+dist/bench-array
+dist/bench-runtime
+
+# the compiler wants the sources and src/ in its working directory
+WORK=build/bench
+rm -rf $WORK
+mkdir -p $WORK
+cp *.tn bench/*.tn $WORK
+cp -r src $WORK
+cd $WORK
+
+for program in binaryTrees cycles strings; do
+  "$TNC" compile $program.tn --release > /dev/null
+  "$ROOT/dist/bench-e2e" "$SAMPLES" "tn $program" "dist/$program"
+done
+
+for module in compiler ast lexer parser; do
+  "$ROOT/dist/bench-e2e" "$SAMPLES" "transpile $module.tn" "$TNC transpile compiler.tn $module.tn"
+done
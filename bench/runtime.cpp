@@ -0,0 +1,141 @@
+// Runtime primitives: refcounting, weak refs, cycle collection, Array, String and File.
+//   clang++-20 -std=c++20 -O3 -march=native -DNDEBUG -Isrc bench/runtime.cpp src/core/*/*.cpp -o dist/bench-runtime
+
+#include "../src/core/core.hpp"
+#include "../src/core/rt/WeakRef.hpp"
+#include "bench.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <utility>
+
+struct Node : virtual public Object {
+  AutoRef<Node> next;
+  REGISTER_CHILDREN(next)
+};
+using $Node = AutoRef<Node>;
+
+constexpr std::size_t GRAPH = 10000;
+
+void refs() {
+  $Node a = $Node::make();
+  bench("AutoRef copy", 1 << 20, [&] {
+    $Node b = a;
+    keep(b);
+  });
+  bench("AutoRef move", 1 << 20, [&] {
+    $Node b = std::move(a);
+    a = std::move(b);
+  });
+  bench("AutoRef make and drop", 1 << 16, [] { keep($Node::make()); });
+
+  WeakRef<Node> weak = a;
+  bench("WeakRef lock", 1 << 20, [&] { keep(weak.lock()); });
+}
+
+// Young collections of GRAPH fresh objects. The graphs are built with the GC paused, so only the collection is timed.
+template <typename Build> void collect(const char *name, Build &&build) {
+  benchTimed(name, [&] {
+    GC::gc().pause();
+    auto root = build();
+    GC::gc().resume();
+    Stopwatch watch;
+    GC::gc().forceCollect();
+    auto elapsed = watch.stop();
+    keep(root);
+    return elapsed;
+  });
+}
+
+void gc() {
+  collect("GC collect 10k live list", [] {
+    $Node head;
+    for (std::size_t i = 0; i < GRAPH; ++i) {
+      $Node node = $Node::make();
+      node->next = head;
+      head = node;
+    }
+    return head;
+  });
+  collect("GC collect 10k live cycle", [] {
+    $Node head = $Node::make(), tail = head;
+    for (std::size_t i = 1; i < GRAPH; ++i) {
+      $Node node = $Node::make();
+      node->next = head;
+      head = node;
+    }
+    tail->next = head;
+    return head;
+  });
+  collect("GC collect 10k garbage cycles", [] {
+    for (std::size_t i = 0; i < GRAPH / 2; ++i) {
+      $Node a = $Node::make(), b = $Node::make();
+      a->next = b;
+      b->next = a;
+    }
+    return $Node();
+  });
+}
+
+void arrays() {
+  bench("Array<i32> push 1k", 1 << 10, [] {
+    auto arr = $Array<i32>::make();
+    for (i32 i = 0; i < 1000; ++i)
+      arr->push(i);
+    keep(arr);
+  });
+  auto strings = $Array<$String>::make();
+  for (std::size_t i = 0; i < 1000; ++i)
+    strings->push(StringFrom(i));
+  bench("Array<String> push 1k", 1 << 8, [&] {
+    auto arr = $Array<$String>::make();
+    for (std::size_t i = 0; i < 1000; ++i)
+      arr->push(strings->at(i));
+    keep(arr);
+  });
+  bench("Array<String> index 1k", 1 << 10, [&] {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < 1000; ++i)
+      n += strings->at(i)->length();
+    keep(n);
+  });
+  bench("Array<String> shift and push", 1 << 16, [&] { strings->push(strings->shift()); });
+}
+
+void strings() {
+  $String word = newString("identifier"), sep = newString(",");
+  std::string csv;
+  for (int i = 0; i < 1000; ++i)
+    csv += std::to_string(i) + ",";
+  $String line = newString(csv);
+
+  bench("String add", 1 << 16, [&] { keep(word->add(word)); });
+  bench("String substring", 1 << 16, [&] { keep(line->substring(100, 200)); });
+  bench("String split 1k fields", 1 << 8, [&] { keep(line->split(sep)); });
+  bench("String hash 4KB", 1 << 12, [&] { keep(newString(csv)->hash()); });
+  bench("String equality", 1 << 20, [&] { keep(*word == word); });
+  bench("String charCodeAt scan 4KB", 1 << 10, [&] {
+    i32 sum = 0;
+    for (std::size_t i = 0; i < line->length(); ++i)
+      sum += line->charCodeAt(i);
+    keep(sum);
+  });
+  bench("parseInt", 1 << 16, [] { keep(parseInt(newString("1234567"))); });
+}
+
+void files() {
+  std::string path = (std::filesystem::temp_directory_path() / "tn-bench-file").string();
+  $String name = newString(path), mb = newString(std::string(1 << 20, 'x'));
+  bench("File write 1MB", 1 << 6, [&] { open(name, newString("w"))->write(mb); });
+  bench("File read 1MB", 1 << 6, [&] { keep(open(name, newString("r"))->read()); });
+  std::remove(path.c_str());
+}
+
+int main() {
+  refs();
+  gc();
+  arrays();
+  strings();
+  files();
+  return 0;
+}
@@ -1,9 +1,13 @@
 #pragma once
 
 #include "ds/array.hpp"
+#include "ds/iterator.hpp"
+#include "ds/map.hpp"
+#include "ds/set.hpp"
 #include "ds/string.hpp"
 #include "ds/toString.hpp"
 #include "ds/valTypes.hpp"
 #include "io/file.hpp"
 #include "io/inOut.hpp"
+#include "rt/Arena.hpp"
 #include "rt/Object.hpp"
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 #include "../rt/AutoRef.hpp"
 #include "../rt/Object.hpp"
+#include "iterator.hpp"
+#include "offsetVector.hpp"
+#include "simd.hpp"
 #include "toString.hpp"
 #include <algorithm>
 #include <concepts>
@@ -18,13 +21,16 @@
 template <typename T> class Array;
 template <typename T> using $Array = AutoRef<Array<T>>;
 template <typename T> class Array : virtual public Object {
-  std::vector<T> data;
+  // numbers get aligned storage and the vectorized kernels from simd.hpp, OffsetVector makes shift/unshift O(1)
+  using Storage = std::conditional_t<Numeric<T>, OffsetVector<T, simd::AlignedAllocator<T>>, OffsetVector<T>>;
+  Storage data;
 
   void $forEachChild(std::function<void(Object *)> visitor) const noexcept override {
     if constexpr (isAutoRef_v<T>)
       for (auto t : data)
         visitor(t.operator->());
   }
+  std::size_t $sizeOf() const noexcept override { return sizeof(*this) + data.capacity() * sizeof(T); }
 
   static std::size_t argSize(const T &) noexcept { return 1; }
   static std::size_t argSize(const $Array<T> &arr) noexcept { return arr->data.size(); }
@@ -64,6 +70,13 @@ public:
       return data[i];
     return data[data.size() + i];
   }
+  // Assignable, `a[i] = x` compiles to this. The reference can be passed back into this array's own mutators
+  // (a.unshift(a[0])); OffsetVector::insert copies such arguments before it grows.
+  decltype(auto) at(const std::ptrdiff_t i) noexcept {
+    if (i >= 0)
+      return data[i];
+    return data[data.size() + i];
+  }
 
   std::size_t push(const T &t) noexcept {
     data.push_back(t);
@@ -84,6 +97,10 @@ public:
     data.erase(data.begin());
     return t;
   }
+  std::size_t unshift(const T &t) noexcept {
+    data.insert(data.begin(), t);
+    return data.size();
+  }
   std::size_t unshift(const $Array<T> &arr) noexcept {
     data.insert(data.begin(), arr->data.begin(), arr->data.end());
     return data.size();
@@ -164,10 +181,15 @@ public:
     return this;
   }
 
-  bool includes(const T &v) const noexcept { return std::find(data.begin(), data.end(), v) != data.end(); }
+  bool includes(const T &v) const noexcept { return indexOf(v) != -1; }
   std::ptrdiff_t indexOf(const T &v) const noexcept {
-    auto it = std::find(data.begin(), data.end(), v);
-    return it == data.end() ? -1 : std::distance(data.begin(), it);
+    if constexpr (Numeric<T>) {
+      std::size_t i = simd::indexOf(data.data(), data.size(), v);
+      return i == data.size() ? -1 : i;
+    } else {
+      auto it = std::find(data.begin(), data.end(), v);
+      return it == data.end() ? -1 : std::distance(data.begin(), it);
+    }
   }
   std::ptrdiff_t lastIndexOf(const T &v) const noexcept {
     auto it = std::find(data.rbegin(), data.rend(), v);
@@ -180,7 +202,10 @@ public:
   }
 
   $Array<T> sort() noexcept {
-    std::sort(data.begin(), data.end());
+    if constexpr (Numeric<T>)
+      simd::sort(data.data(), data.size());
+    else
+      std::sort(data.begin(), data.end());
     return this;
   }
   $Array<T> sort(const std::function<bool(const T &a, const T &b)> &cmp) noexcept {
@@ -188,6 +213,16 @@ public:
     return this;
   }
 
+  // lazy view over the elements, see Iterator
+  $Iterator<T> values() noexcept {
+    return Iterator<T>::template stage<T>([self = $Array<T>(this), i = std::size_t{0}](T &out) mutable {
+      if (i >= self->data.size())
+        return false;
+      out = self->data[i++];
+      return true;
+    });
+  }
+
   void forEach(const std::function<void(const T &, const std::size_t)> &f) const noexcept {
     std::size_t i = 0;
     for (const auto &t : data)
@@ -285,6 +320,48 @@ public:
     return out;
   }
 
+  // sum/min/max of a numeric array, empty arrays give 0
+  T sum() const noexcept
+    requires Numeric<T>
+  {
+    return simd::sum(data.data(), data.size());
+  }
+  T min() const noexcept
+    requires Numeric<T>
+  {
+    return data.empty() ? T{} : simd::min(data.data(), data.size());
+  }
+  T max() const noexcept
+    requires Numeric<T>
+  {
+    return data.empty() ? T{} : simd::max(data.data(), data.size());
+  }
+
+  // elementwise arithmetic, with another array (the result has the length of the shorter one) or with a scalar
+#define OP(name, op, wrap)                                                                                             \
+  $Array<T> name(const $Array<T> &that) const noexcept                                                               \
+    requires Numeric<T>                                                                                                \
+  {                                                                                                                    \
+    std::size_t n = std::min(data.size(), that->data.size());                                                         \
+    auto out = $Array<T>::make();                                                                                      \
+    out->data.resize(n);                                                                                               \
+    simd::apply<wrap>(out->data.data(), data.data(), that->data.data(), n, [](auto a, auto b) { return a op b; });    \
+    return out;                                                                                                        \
+  }                                                                                                                    \
+  $Array<T> name(const T &that) const noexcept                                                                       \
+    requires Numeric<T>                                                                                                \
+  {                                                                                                                    \
+    auto out = $Array<T>::make();                                                                                      \
+    out->data.resize(data.size());                                                                                     \
+    simd::apply<wrap>(out->data.data(), data.data(), that, data.size(), [](auto a, auto b) { return a op b; });       \
+    return out;                                                                                                        \
+  }
+  OP(add, +, true)
+  OP(sub, -, true)
+  OP(mul, *, true)
+  OP(div, /, false)
+#undef OP
+
   bool some(const std::function<bool(const T &, const std::size_t)> &f) const noexcept {
     std::size_t i = 0;
     for (const auto &t : data)
@@ -303,8 +380,8 @@ public:
   $Array<T> fill(const T &value, const std::ptrdiff_t start = 0) noexcept { return fill(value, start, data.size()); }
   $Array<T> fill(const T &value, const std::ptrdiff_t start, const std::ptrdiff_t end) noexcept {
     std::size_t i = normalizeIdx(start), j = normalizeIdx(end);
-    for (; i < j; ++i)
-      data[i] = value;
+    if (i < j)
+      std::fill(data.begin() + i, data.begin() + j, value);
     return this;
   }
 
@@ -368,7 +445,7 @@ public:
     oss << "[";
     bool first = true;
 
-    for (auto &t : data) {
+    for (const auto &t : data) {
       if (first)
         first = false;
       else
@@ -382,4 +459,7 @@ public:
   }
 };
 
+// numeric arrays never reference other objects, so the cycle collector doesn't need to track them
+template <Numeric T> struct isGCLeaf<Array<T>> : std::true_type {};
+
 template <typename T> $Array<T> newArray(std::initializer_list<T> list) { return $Array<T>::make(list); }
\ No newline at end of file
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "../rt/AutoRef.hpp"
+#include "string.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Hashing and equality of Map keys and Set values, with the SameValueZero semantics of JS: strings compare by content,
+// other objects by identity, NaN equals NaN and -0 equals +0.
+template <typename K> struct KeyTraits {
+  static std::size_t hash(const K &k) noexcept {
+    if constexpr (std::is_floating_point_v<K>)
+      return k != k ? 0 : std::hash<K>{}(k == 0 ? K(0) : k);
+    else if constexpr (isAutoRef_v<K>)
+      return std::hash<const void *>{}(k.operator->());
+    else
+      return std::hash<K>{}(k);
+  }
+  static bool equal(const K &a, const K &b) noexcept {
+    if constexpr (std::is_floating_point_v<K>)
+      return a == b || (a != a && b != b);
+    else
+      return a == b;
+  }
+};
+template <> struct KeyTraits<$String> {
+  static std::size_t hash(const $String &k) noexcept { return k ? k->hash() : 0; }
+  static bool equal(const $String &a, const $String &b) noexcept { return a == b || (a && b && *a == b); }
+};
+
+// An insertion ordered hash table. Entries are appended to a dense array, which gives the iteration order, and an open
+// addressing index with linear probing maps hashes to entries. Every entry caches its hash, so probing rarely compares
+// keys and rebuilding never rehashes them. Removed entries are left as holes until the next rebuild.
+template <typename K, typename V> class HashTable {
+public:
+  struct Entry {
+    K key;
+    [[no_unique_address]] V value;
+    std::size_t hash;
+    bool alive;
+  };
+
+private:
+  static constexpr std::uint32_t EMPTY = 0, REMOVED = UINT32_MAX; // other slots hold entry index + 1
+  static constexpr std::size_t MIN_SLOTS = 8;
+
+  std::vector<Entry> entries;
+  std::vector<std::uint32_t> slots; // size is a power of 2, at most half of them are used
+  std::size_t live = 0, used = 0;   // used counts the slots which are not EMPTY
+  mutable std::size_t iterating = 0; // live Iterations
+
+  static std::size_t mix(std::size_t h) noexcept { // murmur3 finalizer, spreads identity hashes over the low bits
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  // slot holding key, or the EMPTY slot ending its probe sequence
+  std::size_t probe(const K &key, const std::size_t h) const noexcept {
+    std::size_t mask = slots.size() - 1;
+    for (std::size_t i = h & mask;; i = (i + 1) & mask) {
+      std::uint32_t s = slots[i];
+      if (s == EMPTY)
+        return i;
+      if (s != REMOVED) {
+        const Entry &e = entries[s - 1];
+        if (e.hash == h && KeyTraits<K>::equal(e.key, key))
+          return i;
+      }
+    }
+  }
+
+  void rebuild(const std::size_t capacity) {
+    if (!iterating) // holes are only compacted when no iteration depends on the positions
+      std::erase_if(entries, [](const Entry &e) { return !e.alive; });
+    std::size_t n = MIN_SLOTS;
+    while (n < capacity * 2)
+      n *= 2;
+    slots.assign(n, EMPTY);
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+      if (!entries[i].alive)
+        continue;
+      std::size_t s = entries[i].hash & (n - 1);
+      while (slots[s] != EMPTY)
+        s = (s + 1) & (n - 1);
+      slots[s] = i + 1;
+    }
+    used = live;
+  }
+
+public:
+  // While an Iteration lives, entries keep their positions: removed ones stay as holes and new ones are appended. So
+  // iterating by index over all(), with the size read again every step, neither skips nor repeats entries when the
+  // table changes in between, and it visits the added ones, like JS does.
+  class Iteration {
+    const HashTable *table;
+
+  public:
+    explicit Iteration(const HashTable *table) noexcept : table(table) { ++table->iterating; }
+    Iteration(const Iteration &that) noexcept : Iteration(that.table) {}
+    Iteration &operator=(const Iteration &) = delete;
+    ~Iteration() { --table->iterating; }
+  };
+  Iteration iterate() const noexcept { return Iteration(this); }
+
+  std::size_t size() const noexcept { return live; }
+  std::size_t bytes() const noexcept {
+    return entries.capacity() * sizeof(Entry) + slots.capacity() * sizeof(std::uint32_t);
+  }
+  const std::vector<Entry> &all() const noexcept { return entries; } // in insertion order, including removed holes
+
+  const Entry *find(const K &key) const noexcept {
+    if (live == 0)
+      return nullptr;
+    std::uint32_t s = slots[probe(key, mix(KeyTraits<K>::hash(key)))];
+    return s == EMPTY ? nullptr : &entries[s - 1];
+  }
+  Entry *find(const K &key) noexcept { return const_cast<Entry *>(std::as_const(*this).find(key)); }
+
+  // entry for key, a new one with a default value is appended if there is none
+  Entry &insert(const K &key) {
+    if ((used + 1) * 2 > slots.size())
+      rebuild(live + 1);
+
+    std::size_t h = mix(KeyTraits<K>::hash(key)), i = probe(key, h);
+    if (slots[i] != EMPTY)
+      return entries[slots[i] - 1];
+
+    entries.push_back(Entry{key, V{}, h, true});
+    slots[i] = entries.size();
+    ++live;
+    ++used;
+    return entries.back();
+  }
+
+  bool erase(const K &key) noexcept {
+    if (live == 0)
+      return false;
+    std::size_t i = probe(key, mix(KeyTraits<K>::hash(key)));
+    if (slots[i] == EMPTY)
+      return false;
+
+    Entry &e = entries[slots[i] - 1];
+    e.key = K{}; // release references right away
+    e.value = V{};
+    e.alive = false;
+    slots[i] = REMOVED;
+    --live;
+    return true;
+  }
+
+  void clear() noexcept {
+    if (iterating) {
+      for (Entry &e : entries) {
+        e.key = K{};
+        e.value = V{};
+        e.alive = false;
+      }
+      std::fill(slots.begin(), slots.end(), EMPTY);
+    } else {
+      entries.clear();
+      slots.clear();
+    }
+    live = used = 0;
+  }
+};
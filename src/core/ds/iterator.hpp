@@ -0,0 +1,133 @@
+#pragma once
+
+#include "../rt/AutoRef.hpp"
+#include "../rt/Object.hpp"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+
+template <typename T> class Array;
+template <typename T> class Iterator;
+template <typename T> using $Iterator = AutoRef<Iterator<T>>;
+
+// A lazy, single pass sequence. Every stage pulls values from the previous one on demand, so a chain like
+// `arr.values().map(...).filter(...).reduce(...)` runs as one loop and never materializes an intermediate array.
+template <typename T> class Iterator : virtual public Object {
+  std::function<bool(T &)> source; // stores the next value in its argument, returns false once exhausted
+
+  // Stages only reference their upstream from inside the source closure, which the cycle collector can't see into,
+  // so there is nothing for it to trace and they are not tracked.
+  template <typename U, typename F> static $Iterator<U> stage(F &&source) noexcept {
+    return $Iterator<U>::makeNoGC(std::function<bool(U &)>(std::forward<F>(source)));
+  }
+
+  template <typename U> friend class Iterator;
+  template <typename U> friend class Array;
+
+public:
+  Iterator(std::function<bool(T &)> source) noexcept : source(std::move(source)) {}
+
+  std::size_t $sizeOf() const noexcept override { return sizeof(*this); }
+
+  // stages share the state of their upstream iterator, like JS iterator helpers do
+  template <typename U> $Iterator<U> map(const std::function<U(const T &, const std::size_t)> &f) noexcept {
+    return stage<U>([self = $Iterator<T>(this), f, i = std::size_t{0}](U &out) mutable {
+      T t;
+      if (!self->source(t))
+        return false;
+      out = f(t, i++);
+      return true;
+    });
+  }
+
+  $Iterator<T> filter(const std::function<bool(const T &, const std::size_t)> &f) noexcept {
+    return stage<T>([self = $Iterator<T>(this), f, i = std::size_t{0}](T &out) mutable {
+      while (self->source(out))
+        if (f(out, i++))
+          return true;
+      return false;
+    });
+  }
+
+  $Iterator<T> take(const std::size_t limit) noexcept {
+    return stage<T>([self = $Iterator<T>(this), remaining = limit](T &out) mutable {
+      if (remaining == 0)
+        return false;
+      --remaining;
+      return self->source(out);
+    });
+  }
+  $Iterator<T> drop(const std::size_t count) noexcept {
+    return stage<T>([self = $Iterator<T>(this), remaining = count](T &out) mutable {
+      for (; remaining > 0; --remaining)
+        if (!self->source(out))
+          return false;
+      return self->source(out);
+    });
+  }
+
+  void forEach(const std::function<void(const T &, const std::size_t)> &f) noexcept {
+    std::size_t i = 0;
+    T t;
+    while (source(t))
+      f(t, i++);
+  }
+
+  T reduce(const std::function<T(const T &, const T &, const std::size_t)> &f) noexcept {
+    T out;
+    if (!source(out))
+      return T{};
+
+    std::size_t i = 1;
+    T t;
+    while (source(t))
+      out = f(out, t, i++);
+    return out;
+  }
+  template <typename U = T>
+  U reduce(const std::function<U(const U &, const T &, const std::size_t)> &f, const U &initial) noexcept {
+    std::size_t i = 0;
+    U out = initial;
+    T t;
+    while (source(t))
+      out = f(out, t, i++);
+    return out;
+  }
+
+  bool some(const std::function<bool(const T &, const std::size_t)> &f) noexcept {
+    std::size_t i = 0;
+    T t;
+    while (source(t))
+      if (f(t, i++))
+        return true;
+    return false;
+  }
+  bool every(const std::function<bool(const T &, const std::size_t)> &f) noexcept {
+    std::size_t i = 0;
+    T t;
+    while (source(t))
+      if (!f(t, i++))
+        return false;
+    return true;
+  }
+
+  T find(const std::function<bool(const T &, const std::size_t)> &f) noexcept {
+    std::size_t i = 0;
+    T t;
+    while (source(t))
+      if (f(t, i++))
+        return t;
+    return T{};
+  }
+
+  AutoRef<Array<T>> toArray() noexcept {
+    auto out = AutoRef<Array<T>>::make();
+    T t;
+    while (source(t))
+      out->push(t);
+    return out;
+  }
+
+  std::string toString() const noexcept { return "[object Iterator]"; }
+};
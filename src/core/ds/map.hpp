@@ -0,0 +1,105 @@
+#pragma once
+
+#include "../rt/AutoRef.hpp"
+#include "../rt/Object.hpp"
+#include "hashTable.hpp"
+#include "iterator.hpp"
+#include "toString.hpp"
+#include <cstddef>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <utility>
+
+template <typename K, typename V> class Map;
+template <typename K, typename V> using $Map = AutoRef<Map<K, V>>;
+template <typename K, typename V> class Map : virtual public Object {
+  HashTable<K, V> table;
+
+  void $forEachChild(std::function<void(Object *)> visitor) const noexcept override {
+    if constexpr (isAutoRef_v<K> || isAutoRef_v<V>)
+      for (auto &e : table.all()) {
+        if constexpr (isAutoRef_v<K>)
+          visitor(e.key.operator->());
+        if constexpr (isAutoRef_v<V>)
+          visitor(e.value.operator->());
+      }
+  }
+  std::size_t $sizeOf() const noexcept override { return sizeof(*this) + table.bytes(); }
+
+public:
+  Map() noexcept {}
+
+  std::size_t size() const noexcept { return table.size(); }
+
+  bool has(const K &key) const noexcept { return table.find(key); }
+  V get(const K &key) const noexcept {
+    auto *e = table.find(key);
+    return e ? e->value : V{};
+  }
+  $Map<K, V> set(const K &key, const V &value) noexcept {
+    table.insert(key).value = value;
+    return this;
+  }
+  bool $delete(const K &key) noexcept { return table.erase(key); }
+  void clear() noexcept { table.clear(); }
+
+  // f may change the map, see HashTable::Iteration; it gets copies since entries move when the map grows
+  void forEach(const std::function<void(const V &, const K &)> &f) const noexcept {
+    auto iteration = table.iterate();
+    for (std::size_t i = 0; i < table.all().size(); ++i)
+      if (table.all()[i].alive) {
+        K key = table.all()[i].key;
+        V value = table.all()[i].value;
+        f(value, key);
+      }
+  }
+
+  // lazy views in insertion order, the map may change while they are in use
+  $Iterator<K> keys() noexcept {
+    // the pair destroys the Iteration before the ref that keeps the table alive
+    return $Iterator<K>::makeNoGC(
+        [state = std::pair($Map<K, V>(this), table.iterate()), i = std::size_t{0}](K &out) mutable {
+          auto &all = state.first->table.all();
+          for (; i < all.size(); ++i)
+            if (all[i].alive) {
+              out = all[i++].key;
+              return true;
+            }
+          return false;
+        });
+  }
+  $Iterator<V> values() noexcept {
+    return $Iterator<V>::makeNoGC(
+        [state = std::pair($Map<K, V>(this), table.iterate()), i = std::size_t{0}](V &out) mutable {
+          auto &all = state.first->table.all();
+          for (; i < all.size(); ++i)
+            if (all[i].alive) {
+              out = all[i++].value;
+              return true;
+            }
+          return false;
+        });
+  }
+
+  std::string toString() const noexcept {
+    std::ostringstream oss;
+    oss << "Map(" << table.size() << ") {";
+    bool first = true;
+    for (auto &e : table.all()) {
+      if (!e.alive)
+        continue;
+      if (first)
+        first = false;
+      else
+        oss << ", ";
+      oss << ::toString(e.key) << " => " << ::toString(e.value);
+    }
+    oss << "}";
+    return oss.str();
+  }
+};
+
+template <typename K, typename V>
+  requires(!isAutoRef_v<K> && !isAutoRef_v<V>)
+struct isGCLeaf<Map<K, V>> : std::true_type {};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// A std::vector which can also grow and shrink at the front in amortized O(1), while the elements stay contiguous.
+// Removing from the front only moves `head` forward. The free slots are compacted away once they outnumber the
+// elements. Inserting at the front reuses the free slots, or makes room proportional to the size when there aren't
+// enough of them.
+template <typename T, typename Alloc = std::allocator<T>> class OffsetVector {
+  static constexpr std::size_t MIN_SLACK = 16;
+
+  std::vector<T, Alloc> buf;
+  std::size_t head = 0; // slots before head are free, they hold default values so that they don't keep objects alive
+
+public:
+  using value_type = T;
+  using reference = typename std::vector<T, Alloc>::reference; // a proxy for std::vector<bool>
+  using const_reference = typename std::vector<T, Alloc>::const_reference;
+  using iterator = typename std::vector<T, Alloc>::iterator;
+  using const_iterator = typename std::vector<T, Alloc>::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  OffsetVector() noexcept {}
+  OffsetVector(std::initializer_list<T> list) : buf(list) {}
+
+  OffsetVector(const OffsetVector &that) : buf(that.begin(), that.end()) {}
+  OffsetVector(OffsetVector &&that) noexcept : buf(std::move(that.buf)), head(std::exchange(that.head, 0)) {}
+  OffsetVector &operator=(const OffsetVector &that) {
+    if (this != &that) {
+      buf.assign(that.begin(), that.end());
+      head = 0;
+    }
+    return *this;
+  }
+  OffsetVector &operator=(OffsetVector &&that) noexcept {
+    buf = std::move(that.buf);
+    head = std::exchange(that.head, 0);
+    return *this;
+  }
+
+  iterator begin() noexcept { return buf.begin() + head; }
+  iterator end() noexcept { return buf.end(); }
+  const_iterator begin() const noexcept { return buf.begin() + head; }
+  const_iterator end() const noexcept { return buf.end(); }
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+  T *data() noexcept { return buf.data() + head; }
+  const T *data() const noexcept { return buf.data() + head; }
+
+  std::size_t size() const noexcept { return buf.size() - head; }
+  std::size_t capacity() const noexcept { return buf.capacity(); } // including the free slots at the front
+  bool empty() const noexcept { return buf.size() == head; }
+
+  reference operator[](const std::size_t i) noexcept { return buf[head + i]; }
+  const_reference operator[](const std::size_t i) const noexcept { return buf[head + i]; }
+  reference front() noexcept { return buf[head]; }
+  const_reference front() const noexcept { return buf[head]; }
+  reference back() noexcept { return buf.back(); }
+  const_reference back() const noexcept { return buf.back(); }
+
+  bool holds(const T *p) const noexcept {
+    if constexpr (std::same_as<T, bool>) // std::vector<bool> packs bits, so no bool * points into it
+      return false;
+    else
+      return std::less_equal<const T *>()(buf.data(), p) && std::less<const T *>()(p, buf.data() + buf.size());
+  }
+
+  void reserve(const std::size_t n) { buf.reserve(head + n); }
+  void resize(const std::size_t n) { buf.resize(head + n); }
+
+  void push_back(const T &t) { buf.push_back(t); }
+  void pop_back() {
+    buf.pop_back();
+    if (empty())
+      clear();
+  }
+  void clear() noexcept {
+    buf.clear();
+    head = 0;
+  }
+
+  // Like std::vector::insert, except that a contiguous range may come from this vector too (a.unshift(a) or a.push(a)).
+  // Other iterators must not point into it.
+  template <typename It> iterator insert(const_iterator pos, It first, It last) {
+    if constexpr (std::contiguous_iterator<It>)
+      if (first != last && holds(std::to_address(first))) {
+        std::vector<T, Alloc> copy(first, last); // growing buf would free the range
+        return insert(pos, copy.begin(), copy.end());
+      }
+    if (pos != begin() || empty())
+      return buf.insert(pos, first, last);
+
+    std::size_t n = std::distance(first, last);
+    if (head < n) {
+      std::size_t grow = n - head + std::max(size(), MIN_SLACK);
+      buf.insert(buf.begin(), grow, T{});
+      head += grow;
+    }
+    head -= n;
+    std::copy(first, last, begin());
+    return begin();
+  }
+  iterator insert(const_iterator pos, const T &t) {
+    T copy = t; // t may be an element, like in a.unshift(a[0])
+    return insert(pos, &copy, &copy + 1);
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    if (first != begin() || first == last)
+      return buf.erase(first, last);
+
+    std::size_t n = std::distance(first, last);
+    std::fill_n(begin(), n, T{});
+    head += n;
+    if (empty())
+      clear();
+    else if (head >= MIN_SLACK && head >= size()) { // the moves are paid for by the removals since the last compaction
+      buf.erase(buf.begin(), buf.begin() + head);
+      head = 0;
+    }
+    return begin();
+  }
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  bool operator==(const OffsetVector &that) const noexcept {
+    return std::equal(begin(), end(), that.begin(), that.end());
+  }
+  bool operator!=(const OffsetVector &that) const noexcept { return !(*this == that); }
+};
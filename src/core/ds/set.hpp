@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../rt/AutoRef.hpp"
+#include "../rt/Object.hpp"
+#include "hashTable.hpp"
+#include "iterator.hpp"
+#include "toString.hpp"
+#include <cstddef>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <utility>
+
+template <typename T> class Set;
+template <typename T> using $Set = AutoRef<Set<T>>;
+template <typename T> class Set : virtual public Object {
+  struct None {};
+  HashTable<T, None> table;
+
+  void $forEachChild(std::function<void(Object *)> visitor) const noexcept override {
+    if constexpr (isAutoRef_v<T>)
+      for (auto &e : table.all())
+        visitor(e.key.operator->());
+  }
+  std::size_t $sizeOf() const noexcept override { return sizeof(*this) + table.bytes(); }
+
+public:
+  Set() noexcept {}
+
+  std::size_t size() const noexcept { return table.size(); }
+
+  bool has(const T &value) const noexcept { return table.find(value); }
+  $Set<T> add(const T &value) noexcept {
+    table.insert(value);
+    return this;
+  }
+  bool $delete(const T &value) noexcept { return table.erase(value); }
+  void clear() noexcept { table.clear(); }
+
+  // f may change the set, see HashTable::Iteration; it gets a copy since entries move when the set grows
+  void forEach(const std::function<void(const T &)> &f) const noexcept {
+    auto iteration = table.iterate();
+    for (std::size_t i = 0; i < table.all().size(); ++i)
+      if (table.all()[i].alive) {
+        T value = table.all()[i].key;
+        f(value);
+      }
+  }
+
+  // lazy view in insertion order, the set may change while it is in use
+  $Iterator<T> values() noexcept {
+    // the pair destroys the Iteration before the ref that keeps the table alive
+    return $Iterator<T>::makeNoGC(
+        [state = std::pair($Set<T>(this), table.iterate()), i = std::size_t{0}](T &out) mutable {
+          auto &all = state.first->table.all();
+          for (; i < all.size(); ++i)
+            if (all[i].alive) {
+              out = all[i++].key;
+              return true;
+            }
+          return false;
+        });
+  }
+  $Iterator<T> keys() noexcept { return values(); }
+
+  std::string toString() const noexcept {
+    std::ostringstream oss;
+    oss << "Set(" << table.size() << ") {";
+    bool first = true;
+    for (auto &e : table.all()) {
+      if (!e.alive)
+        continue;
+      if (first)
+        first = false;
+      else
+        oss << ", ";
+      oss << ::toString(e.key);
+    }
+    oss << "}";
+    return oss.str();
+  }
+};
+
+template <typename T>
+  requires(!isAutoRef_v<T>)
+struct isGCLeaf<Set<T>> : std::true_type {};
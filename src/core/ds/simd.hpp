@@ -0,0 +1,222 @@
+#pragma once
+
+#include "valTypes.hpp"
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// valTypes which get the numeric Array backend. 128 bit types have no vector support, so they use the generic path.
+template <typename T>
+concept Numeric = std::is_arithmetic_v<T> && !std::same_as<T, bool> && sizeof(T) <= 8;
+
+// Vectorized kernels for contiguous numeric data, written with GCC/Clang vector extensions so they stay portable. The
+// vector width follows the target: 32 bytes with AVX, otherwise 16 bytes (SSE2/NEON baseline).
+namespace simd {
+#ifdef __AVX__
+constexpr std::size_t WIDTH = 32;
+#else
+constexpr std::size_t WIDTH = 16;
+#endif
+
+template <typename T> struct VecOf {
+  typedef T type __attribute__((vector_size(WIDTH)));
+};
+template <typename T> using Vec = typename VecOf<T>::type;
+template <typename T> constexpr std::size_t lanes = WIDTH / sizeof(T);
+
+template <typename T, std::size_t Align = 64> struct AlignedAllocator {
+  using value_type = T;
+  template <typename U> struct rebind {
+    using other = AlignedAllocator<U, Align>;
+  };
+
+  AlignedAllocator() noexcept = default;
+  template <typename U> AlignedAllocator(const AlignedAllocator<U, Align> &) noexcept {}
+
+  T *allocate(const std::size_t n) { return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{Align})); }
+  void deallocate(T *p, const std::size_t) noexcept { ::operator delete(p, std::align_val_t{Align}); }
+
+  template <typename U> bool operator==(const AlignedAllocator<U, Align> &) const noexcept { return true; }
+};
+
+// loads and stores don't assume alignment, views into the middle of an array are fine
+template <typename T> inline Vec<T> load(const T *p) noexcept {
+  Vec<T> v;
+  std::memcpy(&v, p, sizeof v);
+  return v;
+}
+template <typename T> inline void store(T *p, const Vec<T> v) noexcept { std::memcpy(p, &v, sizeof v); }
+template <typename T> inline Vec<T> broadcast(const T t) noexcept { return Vec<T>{} + t; }
+
+template <typename M> inline bool any(const M mask) noexcept {
+  std::uint64_t words[sizeof(M) / sizeof(std::uint64_t)];
+  std::memcpy(words, &mask, sizeof mask);
+  std::uint64_t out = 0;
+  for (auto w : words)
+    out |= w;
+  return out;
+}
+
+// index of the first element equal to value, or n
+template <Numeric T> std::size_t indexOf(const T *data, const std::size_t n, const T value) noexcept {
+  const Vec<T> needle = broadcast(value);
+  std::size_t i = 0;
+  for (; i + lanes<T> <= n; i += lanes<T>)
+    if (any(load(data + i) == needle))
+      break;
+  for (; i < n; ++i) // finishes the block with the match, or the tail
+    if (data[i] == value)
+      return i;
+  return n;
+}
+
+// Integer arithmetic wraps around instead of overflowing, so it runs on the unsigned type (which may alias the signed
+// one). Scalars need at least unsigned int, smaller types would be promoted to int and u16 * u16 can overflow that.
+template <typename T> struct Wrapping {
+  using type = T;
+  using scalar = T;
+};
+template <std::integral T> struct Wrapping<T> {
+  using type = std::make_unsigned_t<T>;
+  using scalar = std::common_type_t<type, unsigned>;
+};
+
+// lanes are summed separately, so float results can differ from a sequential sum in the last bits
+template <Numeric T> T sum(const T *data, const std::size_t n) noexcept {
+  using W = typename Wrapping<T>::type;
+  Vec<W> acc{};
+  std::size_t i = 0;
+  for (; i + lanes<T> <= n; i += lanes<T>)
+    acc += load(reinterpret_cast<const W *>(data + i));
+
+  W out = 0;
+  for (std::size_t l = 0; l < lanes<T>; ++l)
+    out += acc[l];
+  for (; i < n; ++i)
+    out += static_cast<W>(data[i]);
+  return static_cast<T>(out);
+}
+
+// n must be > 0
+template <Numeric T, typename Pick> T select(const T *data, const std::size_t n, Pick pick) noexcept {
+  T out = data[0];
+  std::size_t i = 0;
+  if (n >= lanes<T>) {
+    Vec<T> acc = load(data);
+    for (i = lanes<T>; i + lanes<T> <= n; i += lanes<T>) {
+      Vec<T> v = load(data + i);
+      acc = pick(v, acc) ? v : acc;
+    }
+    out = acc[0];
+    for (std::size_t l = 1; l < lanes<T>; ++l)
+      if (pick(acc[l], out))
+        out = acc[l];
+  }
+  for (; i < n; ++i)
+    if (pick(data[i], out))
+      out = data[i];
+  return out;
+}
+template <Numeric T> T min(const T *data, const std::size_t n) noexcept {
+  return select(data, n, [](auto a, auto b) { return a < b; });
+}
+template <Numeric T> T max(const T *data, const std::size_t n) noexcept {
+  return select(data, n, [](auto a, auto b) { return a > b; });
+}
+
+// out[i] = op(a[i], b[i]), op is called with both vectors and scalars. With Wrap it sees integers as Wrapping types,
+// which is right for + - * but not for division.
+template <bool Wrap, Numeric T, typename Op>
+void apply(T *out, const T *a, const T *b, const std::size_t n, Op op) noexcept {
+  using U = std::conditional_t<Wrap, typename Wrapping<T>::type, T>;
+  using S = std::conditional_t<Wrap, typename Wrapping<T>::scalar, T>;
+  U *o = reinterpret_cast<U *>(out);
+  const U *x = reinterpret_cast<const U *>(a), *y = reinterpret_cast<const U *>(b);
+  std::size_t i = 0;
+  for (; i + lanes<T> <= n; i += lanes<T>)
+    store(o + i, op(load(x + i), load(y + i)));
+  for (; i < n; ++i)
+    o[i] = static_cast<U>(op(static_cast<S>(x[i]), static_cast<S>(y[i])));
+}
+template <bool Wrap, Numeric T, typename Op>
+void apply(T *out, const T *a, const T b, const std::size_t n, Op op) noexcept {
+  using U = std::conditional_t<Wrap, typename Wrapping<T>::type, T>;
+  using S = std::conditional_t<Wrap, typename Wrapping<T>::scalar, T>;
+  U *o = reinterpret_cast<U *>(out);
+  const U *x = reinterpret_cast<const U *>(a), y = static_cast<U>(b);
+  const Vec<U> v = broadcast(y);
+  std::size_t i = 0;
+  for (; i + lanes<T> <= n; i += lanes<T>)
+    store(o + i, op(load(x + i), v));
+  for (; i < n; ++i)
+    o[i] = static_cast<U>(op(static_cast<S>(x[i]), static_cast<S>(y)));
+}
+
+// Maps numbers to unsigned keys with the same ordering: the sign bit of integers is flipped, negative floats have all
+// their bits flipped.
+template <Numeric T> struct RadixKey {
+  using Key = std::conditional_t<
+      sizeof(T) == 1, std::uint8_t,
+      std::conditional_t<sizeof(T) == 2, std::uint16_t, std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+  static constexpr Key SIGN = Key(1) << (sizeof(Key) * 8 - 1);
+
+  static Key to(const T t) noexcept {
+    Key k = std::bit_cast<Key>(t);
+    if constexpr (std::is_floating_point_v<T>)
+      return k & SIGN ? Key(~k) : Key(k | SIGN);
+    else if constexpr (std::is_signed_v<T>)
+      return k ^ SIGN;
+    else
+      return k;
+  }
+  static T from(const Key k) noexcept {
+    if constexpr (std::is_floating_point_v<T>)
+      return std::bit_cast<T>(k & SIGN ? Key(k & ~SIGN) : Key(~k));
+    else if constexpr (std::is_signed_v<T>)
+      return std::bit_cast<T>(Key(k ^ SIGN));
+    else
+      return k;
+  }
+};
+
+// LSD radix sort on bytes, passes where every key has the same byte are skipped. Small inputs use std::sort.
+template <Numeric T> void sort(T *data, const std::size_t n) {
+  constexpr std::size_t RADIX_THRESHOLD = 256, BYTES = sizeof(T);
+  if (n < RADIX_THRESHOLD) {
+    std::sort(data, data + n);
+    return;
+  }
+
+  using Key = typename RadixKey<T>::Key;
+  std::vector<Key> keys(n), tmp(n);
+  std::vector<std::size_t> counts(BYTES * 256);
+  for (std::size_t i = 0; i < n; ++i) {
+    Key k = keys[i] = RadixKey<T>::to(data[i]);
+    for (std::size_t b = 0; b < BYTES; ++b)
+      ++counts[b * 256 + ((k >> (b * 8)) & 0xff)];
+  }
+
+  for (std::size_t b = 0; b < BYTES; ++b) {
+    std::size_t *count = counts.data() + b * 256;
+    if (count[(keys[0] >> (b * 8)) & 0xff] == n)
+      continue;
+
+    std::size_t offset = 0;
+    for (std::size_t d = 0; d < 256; ++d)
+      offset += std::exchange(count[d], offset);
+    for (Key k : keys)
+      tmp[count[(k >> (b * 8)) & 0xff]++] = k;
+    keys.swap(tmp);
+  }
+
+  for (std::size_t i = 0; i < n; ++i)
+    data[i] = RadixKey<T>::from(keys[i]);
+}
+} // namespace simd
@@ -0,0 +1,56 @@
+#include "string.hpp"
+#include <algorithm>
+#include <cctype>
+
+$Array<$String> String::split(const $String &sep) {
+  auto out = $Array<$String>::make();
+  size_t start = 0, end = str.find(sep->str);
+
+  while (end != std::string::npos) {
+    out->push($String::make(str.substr(start, end - start)));
+    start = end + sep->str.length();
+    end = str.find(sep->str, start);
+  }
+  out->push($String::make(str.substr(start)));
+
+  return out;
+}
+
+$String String::substring(const std::size_t start, const std::size_t end) const noexcept {
+  std::size_t i = std::max(0ul, start), j = std::min(end, str.length());
+  return $String::make(str.substr(i, j - i));
+}
+
+$String String::add(const $String &that) const noexcept { return $String::make(str + that->str); }
+
+bool String::isInt() const noexcept {
+  try {
+    std::stoi(str);
+    return true;
+  } catch (...) {
+    return false;
+  }
+}
+bool String::isFloat() const noexcept {
+  try {
+    std::stod(str);
+    return true;
+  } catch (...) {
+    return false;
+  }
+}
+bool String::isAlpha() const noexcept {
+  for (char c : str)
+    if (!std::isalpha(c))
+      return false;
+  return true;
+}
+bool String::isAlNum() const noexcept {
+  for (char c : str)
+    if (!std::isalnum(c))
+      return false;
+  return true;
+}
+
+i64 parseInt(const $String &str) { return std::stoi(str->_str()); }
+f64 parseFloat(const $String &str) { return std::stod(str->_str()); }
@@ -4,71 +4,44 @@
 #include "../rt/Object.hpp"
 #include "array.hpp"
 #include "valTypes.hpp"
-#include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <string>
 
 class String;
 using $String = AutoRef<String>;
 class String : virtual public Object {
   std::string str;
+  mutable std::size_t hashCode = 0; // strings are immutable, so the hash is computed once; 0 means not computed yet
 
 public:
   String() noexcept {}
   String(std::string str) : str(str) {}
 
   std::size_t length() const noexcept { return str.length(); }
+  std::size_t $sizeOf() const noexcept override { // short strings live inside std::string
+    return sizeof(*this) + (str.capacity() > std::string().capacity() ? str.capacity() + 1 : 0);
+  }
 
   $String at(std::size_t idx) const noexcept { return $String::make(str.substr(idx, 1)); }
-
-  $Array<$String> split(const $String &sep) {
-    auto out = $Array<$String>::make();
-    size_t start = 0, end = str.find(sep->str);
-
-    while (end != std::string::npos) {
-      out->push($String::make(str.substr(start, end - start)));
-      start = end + sep->str.length();
-      end = str.find(sep->str, start);
-    }
-    out->push($String::make(str.substr(start)));
-
-    return out;
+  // byte at idx, 0 past the end
+  i32 charCodeAt(const std::size_t idx) const noexcept {
+    return idx < str.length() ? static_cast<unsigned char>(str[idx]) : 0;
   }
 
-  $String substring(const std::size_t start, const std::size_t end) const noexcept {
-    std::size_t i = std::max(0ul, start), j = std::min(end, str.length());
-    return $String::make(str.substr(i, j - i));
-  }
+  $Array<$String> split(const $String &sep);
+  $String substring(const std::size_t start, const std::size_t end) const noexcept;
+  $String add(const $String &that) const noexcept;
 
-  $String add(const $String &that) const noexcept { return $String::make(str + that->str); }
+  bool isInt() const noexcept;
+  bool isFloat() const noexcept;
+  bool isAlpha() const noexcept;
+  bool isAlNum() const noexcept;
 
-  bool isInt() const noexcept {
-    try {
-      std::stoi(str);
-      return true;
-    } catch (...) {
-      return false;
-    }
-  }
-  bool isFloat() const noexcept {
-    try {
-      std::stod(str);
-      return true;
-    } catch (...) {
-      return false;
-    }
-  }
-  bool isAlpha() const noexcept {
-    for (char c : str)
-      if (!std::isalpha(c))
-        return false;
-    return true;
-  }
-  bool isAlNum() const noexcept {
-    for (char c : str)
-      if (!std::isalnum(c))
-        return false;
-    return true;
+  std::size_t hash() const noexcept {
+    if (hashCode == 0)
+      hashCode = std::hash<std::string>{}(str);
+    return hashCode;
   }
 
   bool operator==(const $String &that) const noexcept { return str == that->str; }
@@ -81,5 +54,5 @@ public:
 inline $String newString(std::string str) { return $String::make(str); }
 template <typename T> $String StringFrom(T t) { return $String::make(std::to_string(t)); }
 
-inline i64 parseInt(const $String &str) { return std::stoi(str->_str()); }
-inline f64 parseFloat(const $String &str) { return std::stod(str->_str()); }
\ No newline at end of file
+i64 parseInt(const $String &str);
+f64 parseFloat(const $String &str);
\ No newline at end of file
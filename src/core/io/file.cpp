@@ -0,0 +1,34 @@
+#include "file.hpp"
+#include <ios>
+
+File::File(const $String &fname, const $String &mode) : filename(fname) {
+  std::ios_base::openmode m = std::ios_base::in;
+  if (*mode == newString("r"))
+    m = std::ios_base::in;
+  else if (*mode == newString("w"))
+    m = std::ios_base::out | std::ios_base::trunc;
+  else if (*mode == newString("a"))
+    m = std::ios_base::out | std::ios_base::app;
+  else if (*mode == newString("r+"))
+    m = std::ios_base::in | std::ios_base::out;
+
+  stream.open(filename->_str(), m);
+}
+File::~File() { stream.close(); }
+
+$String File::read() noexcept {
+  std::string content, line;
+  while (std::getline(stream, line))
+    content += line + "\n";
+  return newString(content);
+}
+
+$String File::readLine() noexcept {
+  std::string line;
+  std::getline(stream, line);
+  return newString(line);
+}
+
+void File::write(const $String &str) noexcept { stream << str->_str(); }
+
+$File open(const $String &fname, const $String &mode) { return $File::make(fname, mode); }
@@ -4,7 +4,6 @@
 #include "../rt/AutoRef.hpp"
 #include "../rt/Object.hpp"
 #include <fstream>
-#include <ios>
 #include <string>
 
 class File;
@@ -14,35 +13,14 @@ class File : virtual public Object {
   std::fstream stream;
 
 public:
-  File(const $String &fname, const $String &mode) : filename(fname) {
-    std::ios_base::openmode m = std::ios_base::in;
-    if (*mode == newString("r"))
-      m = std::ios_base::in;
-    else if (*mode == newString("w"))
-      m = std::ios_base::out | std::ios_base::trunc;
-    else if (*mode == newString("a"))
-      m = std::ios_base::out | std::ios_base::app;
-    else if (*mode == newString("r+"))
-      m = std::ios_base::in | std::ios_base::out;
+  File(const $String &fname, const $String &mode);
+  ~File();
 
-    stream.open(filename->_str(), m);
-  }
-  ~File() { stream.close(); }
+  std::size_t $sizeOf() const noexcept override { return sizeof(*this); }
 
-  $String read() noexcept {
-    std::string content, line;
-    while (std::getline(stream, line))
-      content += line + "\n";
-    return newString(content);
-  }
-
-  $String readLine() noexcept {
-    std::string line;
-    std::getline(stream, line);
-    return newString(line);
-  }
-
-  void write(const $String &str) noexcept { stream << str->_str(); }
+  $String read() noexcept;
+  $String readLine() noexcept;
+  void write(const $String &str) noexcept;
 };
 
-inline $File open(const $String &fname, const $String &mode) { return $File::make(fname, mode); }
\ No newline at end of file
+$File open(const $String &fname, const $String &mode);
\ No newline at end of file
@@ -0,0 +1,4 @@
+#include "inOut.hpp"
+#include <cstdlib>
+
+i32 system($String command) { return std::system(command->_str().c_str()); }
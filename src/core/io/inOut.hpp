@@ -6,4 +6,5 @@ template <typename... Args> void print(Args &&...args) {
   std::cout << std::endl;
 }
 
-inline void system($String command) { std::system(command->_str().c_str()); }
\ No newline at end of file
+// exit status of the command as returned by std::system, 0 on success
+i32 system($String command);
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Object.hpp"
+#include "gcTelemetry.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+// A region for object graphs that all die together, like the AST of one transpile. While an Arena is active on its
+// thread, new objects are bump allocated from it. They share one Meta which the arena holds a ref to, so refcounting
+// never frees them, and the GC doesn't track them. They are all destroyed at once, in reverse allocation order, when
+// the arena goes away; nothing allocated in it may be referenced after that. Arenas nest, the innermost one is active.
+class Arena {
+  static constexpr std::size_t BLOCK_SIZE = 64 * 1024, ALIGN = alignof(std::max_align_t);
+
+  static inline thread_local Arena *active = nullptr;
+
+  Arena *outer;
+  Meta *meta;
+  std::vector<std::byte *> blocks;
+  std::byte *next = nullptr, *end = nullptr;  // free space in the last block
+  std::byte *fresh = nullptr, *freshEnd = nullptr; // latest allocation, whose Object constructor hasn't run yet
+  std::vector<Object *> objects;
+  std::size_t used = 0;
+
+  void *allocate(std::size_t size) {
+    size = (size + ALIGN - 1) & ~(ALIGN - 1);
+    if (size > static_cast<std::size_t>(end - next)) {
+      std::size_t n = std::max(size, BLOCK_SIZE);
+      next = static_cast<std::byte *>(::operator new(n));
+      end = next + n;
+      blocks.push_back(next);
+    }
+    fresh = next;
+    freshEnd = next += size;
+    used += size;
+    return fresh;
+  }
+
+  // Object is constructed before anything else in a new object can allocate: runtime classes inherit it virtually, and
+  // virtual bases come first, while generated classes have it at the root of their single base chain. So the first
+  // Object constructed after an arena allocation is that allocation's, and its subobject lies somewhere inside the
+  // fresh range (not necessarily at its start). Anything else, like a stack object, gets its own Meta.
+  static Meta *adopt(Object *obj) {
+    Arena *arena = active;
+    auto *p = reinterpret_cast<std::byte *>(obj);
+    if (!arena || p < arena->fresh || p >= arena->freshEnd)
+      return new Meta();
+    arena->fresh = arena->freshEnd = nullptr;
+    arena->objects.push_back(obj);
+    return arena->meta;
+  }
+
+  friend class Object;
+  friend class GC; // heap snapshots list the objects of the active arenas
+
+public:
+  Arena() : outer(std::exchange(active, this)), meta(new Meta()) { meta->incRef(); }
+  ~Arena() {
+    active = outer; // destructors allocate from the outer arena or the heap
+    meta->zeroRef(); // refs between arena objects are dropped without touching the shared count, like in GC
+    for (auto it = objects.rbegin(); it != objects.rend(); ++it) {
+      GCTelemetry::freed(*it);
+      (*it)->~Object();
+    }
+    for (std::byte *block : blocks)
+      ::operator delete(block);
+    if (meta->decWeak() == 1) // WeakRefs to arena objects keep the Meta, they see them as gone
+      delete meta;
+  }
+
+  Arena(Arena &&) = delete;
+  Arena(const Arena &) = delete;
+  Arena &operator=(Arena &&) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  static Arena *current() noexcept { return active; }
+  bool holds(const Object *obj) const noexcept { return obj->meta == meta; }
+
+  std::size_t size() const noexcept { return objects.size(); }
+  std::size_t bytes() const noexcept { return used; }
+};
+
+inline Object::Object() : meta(Arena::adopt(this)) {}
+
+inline void *Object::operator new(const std::size_t size) {
+  if (Arena *arena = Arena::active)
+    return arena->allocate(size);
+  return ::operator new(size);
+}
+inline void Object::operator delete(void *ptr) noexcept { ::operator delete(ptr); } // arena objects are never deleted
@@ -2,13 +2,19 @@
 
 #include "Object.hpp"
 #include "gc.hpp"
+#include "gcTelemetry.hpp"
 #include <atomic>
 #include <cstddef>
 #include <new>
+#include <type_traits>
 #include <utility>
 
 template <typename T> class WeakRef;
 
+// Types whose objects can never hold references to other objects. They can't be part of a cycle, so the cycle
+// collector doesn't track them.
+template <typename T> struct isGCLeaf : std::false_type {};
+
 template <typename T> class AutoRef {
   Meta *meta = nullptr;
   T *obj = nullptr;
@@ -21,8 +27,10 @@ template <typename T> class AutoRef {
     std::atomic_thread_fence(std::memory_order_acquire);
     if (meta && meta->getRef() > 0 && meta->decRef() == 1) {
 #ifndef NO_GC
-      GC::gc().untrack(obj);
+      if constexpr (!isGCLeaf<T>::value) // leaves were never tracked, see make
+        GC::gc().untrack(obj);
 #endif
+      GCTelemetry::freed(obj);
       delete obj;
       if (meta->decWeak() == 1)
         delete meta;
@@ -107,19 +115,39 @@ public:
   std::size_t getWeak() const noexcept { return meta ? meta->getWeak() - 1 : 0; }
 
   template <typename U> AutoRef<U> as() const noexcept {
-    U *u = dynamic_cast<U *>(obj);
+    U *u;
+    if constexpr (std::is_base_of_v<U, T>) // upcasts need no check
+      u = obj;
+    else if constexpr (requires { U::$TYPE; })
+      u = obj ? static_cast<U *>(obj->$as(U::$TYPE)) : nullptr;
+    else
+      u = dynamic_cast<U *>(obj);
     return u ? AutoRef<U>(u) : AutoRef<U>();
   }
+  // as, for when obj is known to be a U (a case of a switch on $type()): a plain static_cast, unless U derives from T
+  // virtually, which static_cast can't undo
+  template <typename U> AutoRef<U> cast() const noexcept {
+    if constexpr (requires { static_cast<U *>(obj); })
+      return obj ? AutoRef<U>(static_cast<U *>(obj)) : AutoRef<U>();
+    else
+      return as<U>();
+  }
 
   template <typename... Args> static AutoRef make(Args &&...args) {
     T *obj = new T(std::forward<Args>(args)...);
+    GCTelemetry::allocated<T>();
 #ifndef NO_GC
-    GC::gc().track(obj);
+    if constexpr (!isGCLeaf<T>::value) {
+      Arena *arena = Arena::current();
+      if (!arena || !arena->holds(obj))
+        GC::gc().track(obj);
+    }
 #endif
     return AutoRef(obj);
   }
 
   template <typename... Args> static AutoRef makeNoGC(Args &&...args) {
+    GCTelemetry::allocated<T>();
     return AutoRef(new T(std::forward<Args>(args)...));
   }
 };
@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 
 struct Meta {
@@ -23,6 +24,16 @@ private:
   enum { MARKED_SHIFT = 1 << 1 };
 };
 
+// Type tag of a compiler generated class, the FNV-1a hash of its name. Tags let AutoRef::as skip dynamic_cast.
+constexpr std::uint64_t $typeId(const char *name) noexcept {
+  std::uint64_t hash = 0xcbf29ce484222325;
+  for (; *name; ++name)
+    hash = (hash ^ static_cast<unsigned char>(*name)) * 0x100000001b3;
+  return hash;
+}
+
+class Arena;
+
 class Object {
   Meta *meta;
 
@@ -32,16 +43,27 @@ class Object {
   Object &operator=(const Object &) = delete;
 
   template <typename T> friend class AutoRef;
+  friend class Arena;
   friend class GC;
 
 public:
-  Object() : meta(new Meta()) {}
+  Object(); // these three are defined in Arena.hpp
   virtual ~Object() {}
 
+  static void *operator new(const std::size_t size);
+  static void operator delete(void *ptr) noexcept;
+
   template <typename T> bool operator==(const T &that) const { return this == that; }
   template <typename T> bool operator!=(const T &that) const { return this != that; }
 
   virtual void $forEachChild(std::function<void(Object *)> visitor) const noexcept {}
+  // bytes this object owns, including its buffers but not its children; used by heap snapshots
+  virtual std::size_t $sizeOf() const noexcept { return sizeof(Object); }
+
+  // Tagged classes return their tag, and from $as this converted to the tagged class `type` if it is the class itself or
+  // one of its bases. Untagged classes (like the runtime ones) return 0 and nullptr.
+  virtual std::uint64_t $type() const noexcept { return 0; }
+  virtual void *$as(const std::uint64_t type) noexcept { return nullptr; }
 };
 
 // Recipe taken from https://www.scs.stanford.edu/~dm/blog/va-opt.html
@@ -62,3 +84,5 @@ public:
   void $forEachChild(std::function<void(Object *)> visitor) const noexcept override {                                  \
     FOR_EACH(VISITOR_CALL, __VA_ARGS__)                                                                                \
   }
+
+#include "Arena.hpp" // Object's constructor and allocation need the complete Arena
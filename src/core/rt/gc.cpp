@@ -0,0 +1,214 @@
+#include "AutoRef.hpp" // has to come first, it pulls gc.hpp in before defining AutoRef
+#include "gc.hpp"
+#include "gcTelemetry.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <typeinfo>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+// With TN_HEAP_SNAPSHOT=<prefix>, SIGUSR2 asks for a snapshot. The handler only sets a flag, the snapshot is taken by
+// the next allocation that checks for a collection and written to <prefix>-<pid>-<n>.jsonl.
+GC::GC() {
+  if (const char *prefix = std::getenv("TN_HEAP_SNAPSHOT")) {
+    snapshotPrefix = prefix;
+    std::signal(SIGUSR2, [](int) { snapshotRequested = 1; });
+  }
+}
+
+GC::~GC() {
+  std::vector<Meta *> metas;
+  metas.reserve(youngTracked.size() + oldTracked.size());
+  for (Object *obj : youngTracked) {
+    obj->meta->zeroRef();
+    metas.push_back(obj->meta);
+  }
+  for (Object *obj : oldTracked) {
+    obj->meta->zeroRef();
+    metas.push_back(obj->meta);
+  }
+
+  for (Object *obj : youngTracked)
+    delete obj;
+  for (Object *obj : oldTracked)
+    delete obj;
+  for (Meta *meta : metas)
+    delete meta;
+}
+
+void GC::track(Object *obj) {
+  // try collecting first
+  if (++objCount == 255) { // objCount wraps around, so we check once every 256 allocations
+    if (snapshotRequested) {
+      snapshotRequested = 0;
+      snapshot(snapshotPrefix + "-" + std::to_string(getpid()) + "-" + std::to_string(++snapshots) + ".jsonl");
+    }
+    if (stats.shouldDoYoungGC(youngTracked.size()))
+      collect(false);
+    else if (stats.shouldDoOldGC(oldTracked.size()))
+      collect(true);
+  }
+
+  std::lock_guard<std::mutex> lk(mtx);
+  youngTracked.insert(obj);
+}
+
+void GC::untrack(Object *obj) {
+  std::lock_guard<std::mutex> lk(mtx);
+  if (!youngTracked.erase(obj))
+    oldTracked.erase(obj);
+}
+
+std::size_t GC::collect(const bool old) {
+  std::vector<Object *> outRefs; // stack
+  const bool telemetry = GCTelemetry::enabled();
+  GCRecord record;
+  record.old = old;
+  {
+    std::lock_guard<std::mutex> lk(mtx); // only one collection at a time
+    std::unordered_set<Object *> &tracked = old ? oldTracked : youngTracked;
+    if (state != IDLE || tracked.empty())
+      return 0;
+    state = COLLECTING;
+    if (telemetry) {
+      record.start = std::chrono::steady_clock::now();
+      record.scanned = tracked.size();
+    }
+
+    // detect objects which have refs from outside (variables)
+    for (Object *obj : tracked) // copy ref
+      obj->meta->copyRef();
+    for (Object *obj : tracked)
+      obj->$forEachChild([](Object *child) {
+        if (child)
+          --child->meta->outRef;
+      });
+
+    // dfs to find all objects with transitive refs from outside
+    outRefs.reserve(tracked.size());
+    for (Object *obj : tracked)
+      if (obj->meta->outRef > 0) // has refs from outside
+        outRefs.push_back(obj);
+    while (!outRefs.empty()) {
+      Object *obj = outRefs.back();
+      outRefs.pop_back();
+      obj->$forEachChild([&outRefs](Object *child) {
+        if (child && child->meta->outRef == 0) {
+          ++child->meta->outRef; // mark as visited
+          outRefs.push_back(child);
+        }
+      });
+    }
+
+    // remove objects with no refs from outside
+    for (auto it = tracked.begin(); it != tracked.end();)
+      if ((*it)->meta->outRef == 0) { // no refs from outside
+        outRefs.push_back(*it);       // reuse stack
+        (*it)->meta->zeroRef();
+        it = tracked.erase(it);
+      } else
+        ++it;
+
+    if (old)
+      stats.updateOld(oldTracked.size());
+    else { // young
+      stats.updateYoung(youngTracked.size());
+      record.promoted = youngTracked.size();
+      // move all leftover young objects to old
+      oldTracked.insert(youngTracked.begin(), youngTracked.end());
+      youngTracked.clear();
+    }
+    record.youngSize = youngTracked.size();
+    record.oldSize = oldTracked.size();
+    record.youngThreshold = stats.youngLimit();
+    record.oldThreshold = stats.oldLimit();
+  }
+
+  // delete unreferenced objects
+  std::vector<Meta *> metas;
+  metas.reserve(outRefs.size());
+  for (Object *obj : outRefs) {
+    metas.push_back(obj->meta);
+    GCTelemetry::freed(obj);
+    delete obj; // TODO: two collect call can run this stage (outside of lock) simultaneously, will there be double
+                // free?
+  }
+  for (Meta *meta : metas)
+    if (meta->decWeak() == 1)
+      delete meta;
+
+  if (telemetry) {
+    record.freed = outRefs.size();
+    record.pause = std::chrono::steady_clock::now() - record.start;
+    GCTelemetry::get().collection(record);
+  }
+
+  if (state == COLLECTING)
+    state = IDLE;
+  return outRefs.size();
+}
+
+void GC::snapshot(std::ostream &out) {
+  std::lock_guard<std::mutex> lk(mtx);
+
+  // number the objects in discovery order, following children into untracked objects (arenas, iterator stages)
+  std::vector<Object *> objects;
+  std::unordered_map<const Object *, std::size_t> ids;
+  auto discover = [&](Object *obj) {
+    if (obj && ids.emplace(obj, objects.size()).second)
+      objects.push_back(obj);
+  };
+  for (Object *obj : youngTracked)
+    discover(obj);
+  for (Object *obj : oldTracked)
+    discover(obj);
+  // arena objects share their arena's refcount, so they are listed per arena instead, innermost first. Only this
+  // thread's arenas are known.
+  std::unordered_map<const Object *, std::size_t> arenaOf;
+  std::size_t arenas = 0;
+  for (Arena *arena = Arena::active; arena; arena = arena->outer, ++arenas)
+    for (Object *obj : arena->objects) {
+      arenaOf.emplace(obj, arenas);
+      discover(obj);
+    }
+  for (std::size_t i = 0; i < objects.size(); ++i)
+    objects[i]->$forEachChild(discover);
+
+  out << "{\"pid\":" << getpid() << ",\"time\":" << std::time(nullptr) << ",\"objects\":" << objects.size()
+      << ",\"arenas\":" << arenas << "}\n";
+  for (std::size_t i = 0; i < objects.size(); ++i) {
+    Object *obj = objects[i];
+    auto arena = arenaOf.find(obj);
+    out << "{\"id\":" << i << ",\"type\":\"" << GCTelemetry::typeName(typeid(*obj)) << "\",\"size\":" << obj->$sizeOf();
+    if (arena != arenaOf.end())
+      out << ",\"refs\":0,\"gen\":\"arena\",\"arena\":" << arena->second;
+    else
+      out << ",\"refs\":" << obj->meta->getRef() << ",\"gen\":\""
+          << (youngTracked.count(obj) ? "young" : oldTracked.count(obj) ? "old" : "untracked") << "\"";
+    out << ",\"edges\":[";
+    bool first = true;
+    obj->$forEachChild([&](Object *child) {
+      if (child) {
+        out << (first ? "" : ",") << ids[child];
+        first = false;
+      }
+    });
+    out << "]}\n";
+  }
+}
+
+bool GC::snapshot(const std::string &path) {
+  std::ofstream out(path);
+  if (!out)
+    return false;
+  snapshot(out);
+  return static_cast<bool>(out);
+}
+
+GC &GC::gc() {
+  static GC gc;
+  return gc;
+}
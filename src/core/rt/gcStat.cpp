@@ -0,0 +1,15 @@
+#include "gcStat.hpp"
+#include <algorithm>
+#include <cmath>
+
+void AdaptiveEstimator::update(ssize_t newValue) {
+  ssize_t delta = newValue - curValue;
+  double exp = std::log1p(gain / minValue) * delta;
+
+  bool shouldShrink = exp < -EXP_LIMIT || exp > EXP_LIMIT;
+  gain = std::clamp(gain * (shouldShrink ? .9 : 1.1), 1e-15, 1.); // modify gain first
+
+  exp = std::log1p(gain / minValue) * delta; // recompute with new gain
+  exp = std::clamp(exp, -EXP_LIMIT, EXP_LIMIT);
+  curValue = std::max(minValue, static_cast<ssize_t>(curValue * std::exp(exp)));
+}
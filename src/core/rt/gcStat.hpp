@@ -1,7 +1,5 @@
 #pragma once
 
-#include <algorithm>
-#include <cmath>
 #include <cstddef>
 #include <numbers>
 #include <unistd.h>
@@ -16,17 +14,7 @@ class AdaptiveEstimator {
 public:
   AdaptiveEstimator(ssize_t minValue) : minValue(minValue), curValue(minValue) {}
 
-  void update(ssize_t newValue) {
-    ssize_t delta = newValue - curValue;
-    double exp = std::log1p(gain / minValue) * delta;
-
-    bool shouldShrink = exp < -EXP_LIMIT || exp > EXP_LIMIT;
-    gain = std::clamp(gain * (shouldShrink ? .9 : 1.1), 1e-15, 1.); // modify gain first
-
-    exp = std::log1p(gain / minValue) * delta; // recompute with new gain
-    exp = std::clamp(exp, -EXP_LIMIT, EXP_LIMIT);
-    curValue = std::max(minValue, static_cast<ssize_t>(curValue * std::exp(exp)));
-  }
+  void update(ssize_t newValue);
 
   inline ssize_t get() const { return curValue; }
 };
@@ -38,6 +26,9 @@ public:
   bool shouldDoYoungGC(size_t youngSize) const { return youngSize > youngThreshold.get(); }
   bool shouldDoOldGC(size_t oldSize) const { return oldSize > oldThreshold.get(); }
 
+  ssize_t youngLimit() const { return youngThreshold.get(); }
+  ssize_t oldLimit() const { return oldThreshold.get(); }
+
   void updateYoung(size_t youngSize) { youngThreshold.update(youngSize); }
   void updateOld(size_t oldSize) { oldThreshold.update(oldSize); }
 };
\ No newline at end of file
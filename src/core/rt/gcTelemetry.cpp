@@ -0,0 +1,146 @@
+#include "gcTelemetry.hpp"
+#include "Object.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <unistd.h>
+
+void PauseHistogram::add(const std::chrono::nanoseconds pause) noexcept {
+  auto us = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(pause).count());
+  ++buckets[std::min<std::size_t>(std::bit_width(us), buckets.size() - 1)];
+  ++total;
+}
+
+std::chrono::microseconds PauseHistogram::percentile(const double p) const noexcept {
+  if (total == 0)
+    return std::chrono::microseconds(0);
+  std::uint64_t rank = std::min(static_cast<std::uint64_t>(p * total), total - 1), seen = 0;
+  std::size_t i = 0;
+  while ((seen += buckets[i]) <= rank)
+    ++i;
+  return std::chrono::microseconds(std::uint64_t{1} << i);
+}
+
+GCTelemetry::GCTelemetry() {
+  if (!std::getenv("TN_GC_STATS") && !std::getenv("TN_GC_TRACE"))
+    return;
+  on.store(true, std::memory_order_relaxed);
+  std::atexit([] {
+    GCTelemetry &t = get();
+    if (std::getenv("TN_GC_STATS"))
+      std::cerr << t.report();
+    if (const char *path = std::getenv("TN_GC_TRACE"))
+      std::ofstream(path) << t.trace();
+  });
+}
+
+GCTelemetry &GCTelemetry::get() {
+  static GCTelemetry *telemetry = new GCTelemetry();
+  return *telemetry;
+}
+
+// Reads the environment during static initialization, so enabled() is a plain load. Allocations by static initializers
+// that run before this one aren't counted.
+[[maybe_unused]] static GCTelemetry &fromEnvironment = GCTelemetry::get();
+
+void GCTelemetry::count(const std::type_info &type, const bool alloc) {
+  std::lock_guard<std::mutex> lk(mtx);
+  TypeCounts &c = counts[type];
+  ++(alloc ? c.allocated : c.freed);
+}
+
+void GCTelemetry::countFree(const Object *obj) { count(typeid(*obj), false); }
+
+void GCTelemetry::collection(const GCRecord &record) {
+  std::lock_guard<std::mutex> lk(mtx);
+  history.push_back(record);
+  (record.old ? oldPauses : youngPauses).add(record.pause);
+}
+
+std::vector<GCRecord> GCTelemetry::records() const {
+  std::lock_guard<std::mutex> lk(mtx);
+  return history;
+}
+
+PauseHistogram GCTelemetry::pauses(const bool old) const {
+  std::lock_guard<std::mutex> lk(mtx);
+  return old ? oldPauses : youngPauses;
+}
+
+std::unordered_map<std::type_index, TypeCounts> GCTelemetry::types() const {
+  std::lock_guard<std::mutex> lk(mtx);
+  return counts;
+}
+
+static std::string demangle(const char *name) {
+  int status;
+  std::unique_ptr<char, decltype(&std::free)> readable(abi::__cxa_demangle(name, nullptr, nullptr, &status), std::free);
+  return status == 0 ? readable.get() : name;
+}
+
+std::string GCTelemetry::typeName(const std::type_info &type) { return demangle(type.name()); }
+
+std::string GCTelemetry::report() const {
+  std::vector<GCRecord> records = this->records();
+  PauseHistogram young = pauses(false), old = pauses(true);
+  std::vector<std::pair<std::string, TypeCounts>> sorted;
+  for (auto &[type, c] : types())
+    sorted.emplace_back(demangle(type.name()), c);
+  std::sort(sorted.begin(), sorted.end(),
+            [](auto &a, auto &b) { return a.second.allocated > b.second.allocated; });
+
+  std::chrono::nanoseconds total{0};
+  std::size_t freed = 0;
+  for (const GCRecord &r : records) {
+    total += r.pause;
+    freed += r.freed;
+  }
+
+  std::ostringstream oss;
+  oss << "GC: " << young.count() << " young and " << old.count() << " old collections, " << freed << " objects freed, "
+      << std::chrono::duration<double, std::milli>(total).count() << " ms paused\n";
+  for (auto [name, h] : {std::pair{"young", &young}, std::pair{"old", &old}})
+    if (h->count())
+      oss << "  " << name << " pauses: p50 < " << h->percentile(.5).count() << "us, p99 < " << h->percentile(.99).count()
+          << "us, max < " << h->percentile(1).count() << "us\n";
+  oss << "allocated        live  type\n";
+  for (std::size_t i = 0; i < sorted.size() && i < 20; ++i) {
+    char line[32];
+    std::snprintf(line, sizeof line, "%9llu %11llu  ", static_cast<unsigned long long>(sorted[i].second.allocated),
+                  static_cast<unsigned long long>(sorted[i].second.live()));
+    oss << line << sorted[i].first << "\n";
+  }
+  return oss.str();
+}
+
+std::string GCTelemetry::trace() const {
+  auto us = [this](std::chrono::steady_clock::time_point t) {
+    return std::chrono::duration<double, std::micro>(t - origin).count();
+  };
+  int pid = getpid();
+
+  std::ostringstream oss;
+  oss << "{\"traceEvents\":[\n";
+  bool first = true;
+  for (const GCRecord &r : records()) {
+    double ts = us(r.start), end = us(r.start + r.pause);
+    if (!first)
+      oss << ",\n";
+    first = false;
+    oss << "{\"name\":\"" << (r.old ? "old GC" : "young GC") << "\",\"cat\":\"gc\",\"ph\":\"X\",\"pid\":" << pid
+        << ",\"tid\":1,\"ts\":" << ts << ",\"dur\":" << end - ts << ",\"args\":{\"scanned\":" << r.scanned
+        << ",\"freed\":" << r.freed << ",\"promoted\":" << r.promoted << "}},\n";
+    oss << "{\"name\":\"tracked\",\"ph\":\"C\",\"pid\":" << pid << ",\"ts\":" << end << ",\"args\":{\"young\":"
+        << r.youngSize << ",\"old\":" << r.oldSize << "}},\n";
+    oss << "{\"name\":\"thresholds\",\"ph\":\"C\",\"pid\":" << pid << ",\"ts\":" << end << ",\"args\":{\"young\":"
+        << r.youngThreshold << ",\"old\":" << r.oldThreshold << "}}";
+  }
+  oss << "\n]}\n";
+  return oss.str();
+}
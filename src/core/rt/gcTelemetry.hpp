@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+class Object;
+
+// What one collection did. Sizes and thresholds are the ones left after it.
+struct GCRecord {
+  bool old = false;
+  std::size_t scanned = 0, freed = 0, promoted = 0; // promoted young objects, 0 for old collections
+  std::size_t youngSize = 0, oldSize = 0;
+  std::ptrdiff_t youngThreshold = 0, oldThreshold = 0;
+  std::chrono::steady_clock::time_point start{};
+  std::chrono::nanoseconds pause{};
+};
+
+// Pause counts in power of 2 buckets: bucket 0 holds pauses under 1us, bucket i the ones under 2^i us.
+class PauseHistogram {
+  std::array<std::uint64_t, 32> buckets{};
+  std::uint64_t total = 0;
+
+public:
+  void add(const std::chrono::nanoseconds pause) noexcept;
+
+  std::uint64_t count() const noexcept { return total; }
+  const std::array<std::uint64_t, 32> &counts() const noexcept { return buckets; }
+  // upper bound of the bucket holding the pause at fraction p (0 to 1) of the sorted pauses
+  std::chrono::microseconds percentile(const double p) const noexcept;
+};
+
+struct TypeCounts {
+  std::uint64_t allocated = 0, freed = 0;
+  // frees of objects allocated before telemetry was enabled are counted too, so there can be more frees
+  std::uint64_t live() const noexcept { return allocated > freed ? allocated - freed : 0; }
+};
+
+// Opt-in instrumentation of the GC and of allocations. It is off unless TN_GC_STATS or TN_GC_TRACE is set, or enable()
+// is called; the hooks are a single branch then. TN_GC_STATS prints a summary to stderr at exit, TN_GC_TRACE=<file>
+// writes the collections there as Chrome trace events (chrome://tracing or ui.perfetto.dev).
+class GCTelemetry {
+  static inline std::atomic<bool> on{false}; // constant initialized, so hooks during static initialization see it
+
+  mutable std::mutex mtx;
+  std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+  std::vector<GCRecord> history;
+  PauseHistogram youngPauses, oldPauses;
+  std::unordered_map<std::type_index, TypeCounts> counts;
+
+  GCTelemetry();
+
+  void count(const std::type_info &type, const bool alloc);
+  void countFree(const Object *obj); // by dynamic type
+
+public:
+  static GCTelemetry &get(); // never destroyed, so it can still count while statics are torn down
+  static bool enabled() noexcept { return on.load(std::memory_order_relaxed); }
+  static void enable() noexcept {
+    get(); // so that the instance exists before any hook needs it
+    on.store(true, std::memory_order_relaxed);
+  }
+  static void disable() noexcept { on.store(false, std::memory_order_relaxed); }
+
+  template <typename T> static void allocated() {
+    if (enabled())
+      get().count(typeid(T), true);
+  }
+  static void freed(const Object *obj) {
+    if (enabled())
+      get().countFree(obj);
+  }
+  void collection(const GCRecord &record);
+
+  std::vector<GCRecord> records() const;
+  PauseHistogram pauses(const bool old) const;
+  std::unordered_map<std::type_index, TypeCounts> types() const;
+
+  static std::string typeName(const std::type_info &type); // demangled
+
+  std::string report() const;
+  std::string trace() const; // Chrome trace event JSON
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "../src/core/core.hpp"
+#include <cstdio>
+#include <string>
+#include <type_traits>
+
+// The C++ tests report like the .tn ones: a line per check, and main returns the number of failed checks.
+inline int failures = 0;
+
+template <typename T> std::string show(const T &t) {
+  if constexpr (std::is_convertible_v<T, std::string>)
+    return t;
+  else
+    return ::toString(t);
+}
+
+template <typename A, typename B> void check(const char *name, const A &actual, const B &expected) {
+  if (actual == expected) {
+    std::printf("ok %s\n", name);
+    return;
+  }
+  std::printf("FAIL %s: %s, expected %s\n", name, show(actual).c_str(), show(expected).c_str());
+  ++failures;
+}
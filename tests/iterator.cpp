@@ -0,0 +1,74 @@
+// Iterator: lazy stages pulled one value at a time, see src/core/ds/iterator.hpp.
+
+#include "check.hpp"
+
+$Array<int> range(const int from, const int to) {
+  auto out = $Array<int>::make();
+  for (int i = from; i < to; ++i)
+    out->push(i);
+  return out;
+}
+
+int main() {
+  auto xs = range(1, 11);
+
+  int mapped = 0;
+  auto squares = xs->values()
+                     ->map<int>([&](const int &x, std::size_t) {
+                       ++mapped;
+                       return x * x;
+                     })
+                     ->filter([](const int &x, std::size_t) { return x % 2 == 1; })
+                     ->take(2)
+                     ->toArray();
+  check("map, filter and take", show(squares), "[1, 9]");
+  check("stages only pull what take needs", mapped, 3);
+
+  mapped = 0;
+  auto none = xs->values()
+                  ->map<int>([&](const int &x, std::size_t) {
+                    ++mapped;
+                    return x;
+                  })
+                  ->take(0)
+                  ->toArray();
+  check("take(0) is empty", none->length(), std::size_t{0});
+  check("take(0) pulls nothing", mapped, 0);
+
+  check("drop", show(xs->values()->drop(7)->toArray()), "[8, 9, 10]");
+  check("drop past the end", xs->values()->drop(20)->toArray()->length(), std::size_t{0});
+  check("drop then take", show(xs->values()->drop(2)->take(3)->toArray()), "[3, 4, 5]");
+
+  std::string indexes;
+  xs->values()
+      ->filter([](const int &x, std::size_t) { return x > 5; })
+      ->map<int>([&](const int &x, const std::size_t i) {
+        indexes += std::to_string(i);
+        return x;
+      })
+      ->toArray();
+  check("each stage counts its own indexes", indexes, "01234");
+
+  check("reduce", xs->values()->reduce([](const int &a, const int &b, std::size_t) { return a + b; }), 55);
+  check("reduce of nothing", range(0, 0)->values()->reduce([](const int &a, const int &b, std::size_t) { return a + b; }),
+        0);
+  check("reduce into another type",
+        xs->values()->take(3)->reduce<std::string>(
+            [](const std::string &s, const int &x, std::size_t) { return s + std::to_string(x); }, ">"),
+        ">123");
+  check("filter and reduce",
+        xs->values()
+            ->filter([](const int &x, std::size_t) { return x % 3 == 0; })
+            ->reduce([](const int &a, const int &b, std::size_t) { return a * b; }),
+        162);
+
+  auto shared = xs->values();
+  auto head = shared->take(2)->toArray();
+  check("a stage consumes its upstream", show(head), "[1, 2]");
+  check("the upstream continues after it", show(shared->take(3)->toArray()), "[3, 4, 5]");
+
+  check("some", xs->values()->some([](const int &x, std::size_t) { return x == 7; }), true);
+  check("every", xs->values()->every([](const int &x, std::size_t) { return x < 10; }), false);
+  check("find", xs->values()->find([](const int &x, std::size_t) { return x * x > 50; }), 8);
+  return failures;
+}
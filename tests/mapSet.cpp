@@ -0,0 +1,193 @@
+// Map and Set: insertion order through deletes and re-inserts, and changes while forEach or an iterator is running,
+// which must visit additions and never skip or repeat entries. See src/core/ds/hashTable.hpp.
+
+#include "check.hpp"
+#include <cmath>
+#include <string>
+#include <vector>
+
+template <typename K, typename V> std::string keysOf(const $Map<K, V> &map) {
+  std::string out;
+  map->forEach([&](const V &, const K &key) { out += (out.empty() ? "" : " ") + show(key); });
+  return out;
+}
+template <typename T> std::string valuesOf(const $Set<T> &set) {
+  std::string out;
+  set->forEach([&](const T &value) { out += (out.empty() ? "" : " ") + show(value); });
+  return out;
+}
+
+$Map<int, int> mapOf(const int n) {
+  auto map = $Map<int, int>::make();
+  for (int i = 1; i <= n; ++i)
+    map->set(i, i * 10);
+  return map;
+}
+$Set<int> setOf(const int n) {
+  auto set = $Set<int>::make();
+  for (int i = 1; i <= n; ++i)
+    set->add(i);
+  return set;
+}
+
+void mapOrder() {
+  auto map = mapOf(5);
+  map->$delete(2);
+  map->set(2, 0);
+  check("a re-inserted key goes last", keysOf(map), "1 3 4 5 2");
+  map->set(3, 33);
+  check("setting a key keeps its place", keysOf(map) + " / " + show(map->get(3)), "1 3 4 5 2 / 33");
+  check("deleting a missing key", map->$delete(9), false);
+  check("a deleted key is gone", map->$delete(1) && !map->has(1) && map->get(1) == 0, true);
+
+  // enough deletes and inserts to rebuild the table a few times
+  auto big = $Map<int, int>::make();
+  std::string expected;
+  for (int i = 0; i < 1000; ++i)
+    big->set(i, i);
+  for (int i = 0; i < 1000; i += 2)
+    big->$delete(i);
+  for (int i = 0; i < 10; ++i)
+    big->set(i, -i);
+  for (int i = 1; i < 1000; i += 2)
+    expected += std::to_string(i) + " ";
+  check("order survives rebuilds", keysOf(big), expected + "0 2 4 6 8");
+  check("and so do the values", big->size() == 505 && big->get(3) == -3 && big->get(4) == -4 && big->get(999) == 999,
+        true);
+
+  auto strings = $Map<$String, int>::make();
+  strings->set(newString("key"), 1);
+  strings->set(newString("other"), 2);
+  strings->set(newString("key"), 3);
+  check("string keys compare by content", strings->size() == 2 && strings->get(newString("key")) == 3, true);
+  strings->$delete(newString("key"));
+  strings->set(newString("key"), 4);
+  check("and re-insert last", keysOf(strings), "other key");
+
+  auto numbers = $Map<f64, int>::make();
+  numbers->set(NAN, 1);
+  numbers->set(-0.0, 2);
+  numbers->set(NAN, 3);
+  check("NaN and -0 are one key each", numbers->size() == 2 && numbers->get(NAN) == 3 && numbers->get(0.0) == 2, true);
+}
+
+void mapMutation() {
+  std::string visited;
+  auto map = mapOf(3);
+  map->forEach([&](const int &, const int &key) {
+    visited += std::to_string(key) + " ";
+    if (key < 10)
+      map->set(key + 10, 0);
+  });
+  check("forEach visits additions", visited, "1 2 3 11 12 13 ");
+
+  visited = "";
+  map = mapOf(4);
+  map->forEach([&](const int &, const int &key) {
+    visited += std::to_string(key) + " ";
+    if (key == 1)
+      map->$delete(3);
+  });
+  check("forEach skips an entry deleted before it", visited, "1 2 4 ");
+
+  visited = "";
+  map = mapOf(2);
+  int rounds = 0;
+  map->forEach([&](const int &, const int &key) {
+    visited += std::to_string(key) + " ";
+    if (key == 1 && rounds++ == 0) {
+      map->$delete(1);
+      map->set(1, 0);
+    }
+  });
+  check("forEach visits a re-inserted entry again", visited, "1 2 1 ");
+
+  int count = 0;
+  map = mapOf(3);
+  map->forEach([&](const int &, const int &key) {
+    ++count;
+    if (key == 1) { // grows the table, which keeps the holes while forEach runs
+      map->$delete(2);
+      for (int i = 100; i < 200; ++i)
+        map->set(i, 0);
+    }
+  });
+  check("forEach over a growing map", count, 102);
+  check("the map after it", map->size(), std::size_t{102});
+
+  visited = "";
+  map = mapOf(3);
+  map->forEach([&](const int &, const int &key) {
+    visited += std::to_string(key) + " ";
+    if (key == 1) {
+      map->clear();
+      map->set(7, 0);
+    }
+  });
+  check("clear during forEach", visited + keysOf(map), "1 7 7");
+
+  map = mapOf(5);
+  auto keys = map->keys();
+  auto first = keys->take(2)->toArray();
+  map->$delete(3);
+  map->$delete(1);
+  map->set(6, 0);
+  map->set(1, 0);
+  check("keys() continues after changes", show(first) + " " + show(keys->toArray()), "[1, 2] [4, 5, 6, 1]");
+
+  map = mapOf(3);
+  auto values = map->values();
+  std::string seen;
+  values->forEach([&](const int &value, std::size_t) {
+    seen += std::to_string(value) + " ";
+    if (value == 10) {
+      map->clear();
+      map->set(4, 40);
+    }
+  });
+  check("clear during values()", seen, "10 40 ");
+  check("a finished iterator stays finished", keys->toArray()->length(), std::size_t{0});
+}
+
+void setOrderAndMutation() {
+  auto set = setOf(4);
+  set->$delete(1);
+  set->add(1);
+  set->add(3);
+  check("set order after a re-insert", valuesOf(set), "2 3 4 1");
+  check("set has and delete", set->has(1) && set->$delete(1) && !set->has(1) && !set->$delete(1), true);
+
+  std::string visited;
+  set = setOf(3);
+  set->forEach([&](const int &value) {
+    visited += std::to_string(value) + " ";
+    if (value == 1)
+      set->$delete(2);
+    if (value < 3)
+      set->add(value + 3);
+  });
+  check("set forEach with deletes and additions", visited, "1 3 4 ");
+
+  set = setOf(3);
+  auto values = set->values();
+  visited = "";
+  bool cleared = false;
+  values->forEach([&](const int &value, std::size_t) {
+    visited += std::to_string(value) + " ";
+    if (value == 2 && !cleared) { // the 2 added back is visited again, like in JS
+      cleared = true;
+      set->clear();
+      set->add(2);
+      set->add(9);
+    }
+  });
+  check("clear during set values()", visited, "1 2 2 9 ");
+  check("set keys() is values()", show(set->keys()->toArray()), "[2, 9]");
+}
+
+int main() {
+  mapOrder();
+  mapMutation();
+  setOrderAndMutation();
+  return failures;
+}
@@ -0,0 +1,134 @@
+// Numeric Array kernels from src/core/ds/simd.hpp against plain loops, for every length up to a few vectors so that
+// each tail size is hit, and radix sort on both sides of its threshold.
+
+#include "check.hpp"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+template <typename T> std::vector<T> randomValues(const std::size_t n, const unsigned seed, const bool zero = true) {
+  std::mt19937 rng(seed);
+  std::vector<T> out;
+  while (out.size() < n) {
+    T t = static_cast<T>(static_cast<int>(rng() % 101) - 50); // exact in every type, i8 sums and products wrap
+    if (std::is_unsigned_v<T>)
+      t = static_cast<T>(rng() % 50);
+    if (zero || t != T{})
+      out.push_back(t);
+  }
+  return out;
+}
+
+template <typename T> $Array<T> arrayOf(const std::vector<T> &values) {
+  auto out = $Array<T>::make();
+  for (const T &t : values)
+    out->push(t);
+  return out;
+}
+
+template <typename T> bool same(const $Array<T> &array, const std::vector<T> &expected) {
+  if (array->length() != expected.size())
+    return false;
+  for (std::size_t i = 0; i < expected.size(); ++i)
+    if (array->at(i) != expected[i])
+      return false;
+  return true;
+}
+
+// the first length where the kernel and the loop disagree, -1 if none
+template <typename T, typename F> long firstMismatch(F &&agrees) {
+  for (std::size_t n = 0; n <= 100; ++n)
+    if (!agrees(n))
+      return static_cast<long>(n);
+  return -1;
+}
+
+template <typename T> void kernels(const std::string &type) {
+  auto name = [&](const char *what) { return type + " " + what; };
+
+  check(name("sum").c_str(), firstMismatch<T>([](std::size_t n) {
+          std::vector<T> v = randomValues<T>(n, n);
+          long long expected = 0;
+          for (T t : v)
+            expected += static_cast<long long>(t);
+          return arrayOf(v)->sum() == static_cast<T>(expected); // integer sums wrap, float ones are exact here
+        }),
+        -1L);
+  check(name("min and max").c_str(), firstMismatch<T>([](std::size_t n) {
+          std::vector<T> v = randomValues<T>(n, n + 1000);
+          auto array = arrayOf(v);
+          if (n == 0)
+            return array->min() == T{} && array->max() == T{};
+          return array->min() == *std::min_element(v.begin(), v.end()) &&
+                 array->max() == *std::max_element(v.begin(), v.end());
+        }),
+        -1L);
+
+  auto elementwise = [&](const char *what, auto op, auto kernel, auto scalarKernel) {
+    check(name(what).c_str(), firstMismatch<T>([&](std::size_t n) {
+            std::vector<T> a = randomValues<T>(n, n + 2000, false), b = randomValues<T>(n + n % 3, n + 3000, false);
+            std::vector<T> pairs, scalars;
+            for (std::size_t i = 0; i < n; ++i) {
+              pairs.push_back(static_cast<T>(op(a[i], b[i])));
+              scalars.push_back(static_cast<T>(op(a[i], T{3})));
+            }
+            // the longer array is cut to the shorter one, both ways round (so neither side has zeros to divide by)
+            return same(kernel(arrayOf(a), arrayOf(b)), pairs) && kernel(arrayOf(b), arrayOf(a))->length() == n &&
+                   same(scalarKernel(arrayOf(a), T{3}), scalars);
+          }),
+          -1L);
+  };
+  elementwise("add", [](T x, T y) { return x + y; }, [](auto a, auto b) { return a->add(b); },
+              [](auto a, T s) { return a->add(s); });
+  elementwise("sub", [](T x, T y) { return x - y; }, [](auto a, auto b) { return a->sub(b); },
+              [](auto a, T s) { return a->sub(s); });
+  elementwise("mul", [](T x, T y) { return x * y; }, [](auto a, auto b) { return a->mul(b); },
+              [](auto a, T s) { return a->mul(s); });
+  elementwise("div", [](T x, T y) { return x / y; }, [](auto a, auto b) { return a->div(b); },
+              [](auto a, T s) { return a->div(s); });
+
+  check(name("indexOf").c_str(), firstMismatch<T>([](std::size_t n) {
+          std::vector<T> v = randomValues<T>(n, n + 4000);
+          auto array = arrayOf(v);
+          for (std::size_t i = 0; i < n; ++i)
+            if (array->indexOf(v[i]) != std::find(v.begin(), v.end(), v[i]) - v.begin())
+              return false;
+          return array->indexOf(T{99}) == -1; // never generated
+        }),
+        -1L);
+
+  for (std::size_t n : {0, 1, 2, 100, 255, 256, 257, 1000, 5000}) {
+    std::vector<T> v = randomValues<T>(n, n + 5000);
+    if constexpr (std::is_floating_point_v<T>)
+      for (std::size_t i = 0; i < n; i += 7)
+        v[i] = static_cast<T>(v[i] / 4.0); // fractions too
+    std::vector<T> expected = v;
+    std::sort(expected.begin(), expected.end());
+    check(name(("sort of " + std::to_string(n)).c_str()).c_str(), same(arrayOf(v)->sort(), expected), true);
+  }
+}
+
+int main() {
+  kernels<i8>("i8");
+  kernels<u16>("u16");
+  kernels<i32>("i32");
+  kernels<u32>("u32");
+  kernels<i64>("i64");
+  kernels<f32>("f32");
+  kernels<f64>("f64");
+
+  std::vector<f64> extremes{1e300, -1e300, 0.5, -0.5, 3, -3, 1e-300, -1e-300};
+  std::vector<i64> wide{INT64_MAX, INT64_MIN, -1, 0, 1, INT64_MIN + 1, INT64_MAX - 1};
+  for (std::size_t i = 0; i < 300; ++i) {
+    extremes.push_back(extremes[i % 8] * (i % 5 + 1));
+    wide.push_back(wide[i % 7] / static_cast<i64>(i % 9 + 1));
+  }
+  std::vector<f64> sortedExtremes = extremes;
+  std::sort(sortedExtremes.begin(), sortedExtremes.end());
+  std::vector<i64> sortedWide = wide;
+  std::sort(sortedWide.begin(), sortedWide.end());
+  check("radix sort of doubles across the exponent range", same(arrayOf(extremes)->sort(), sortedExtremes), true);
+  check("radix sort of the whole i64 range", same(arrayOf(wide)->sort(), sortedWide), true);
+  return failures;
+}
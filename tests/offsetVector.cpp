@@ -0,0 +1,149 @@
+// OffsetVector: front removals only move the head, which is compacted away once the free slots outnumber the elements.
+// See src/core/ds/offsetVector.hpp.
+
+#include "check.hpp"
+#include "../src/core/ds/offsetVector.hpp"
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+template <typename A, typename B> bool same(const A &a, const B &b) {
+  return std::equal(a.begin(), a.end(), b.begin(), b.end());
+}
+
+// random edits at both ends and in the middle against a std::deque, the first step where they differ or -1
+long randomEdits(const unsigned seed) {
+  std::mt19937 rng(seed);
+  OffsetVector<std::string> v;
+  std::deque<std::string> expected;
+  int next = 0;
+  for (long step = 0; step < 20000; ++step) {
+    std::size_t size = expected.size(), k = rng() % 4 + 1;
+    std::vector<std::string> items;
+    for (std::size_t i = 0; i < k; ++i)
+      items.push_back("item " + std::to_string(next++)); // too long for the small string buffer, ASan sees the heap
+    switch (rng() % 8) {
+    case 0: // bursts of shifts to cross the compaction point, pushes (which are more likely) keep it from emptying
+      for (std::size_t i = 0; i < k * 4 && !expected.empty(); ++i) {
+        v.erase(v.begin());
+        expected.pop_front();
+      }
+      break;
+    case 1:
+      k = std::min(k, size);
+      v.erase(v.begin(), v.begin() + k);
+      expected.erase(expected.begin(), expected.begin() + k);
+      break;
+    case 2:
+      v.insert(v.begin(), items[0]);
+      expected.push_front(items[0]);
+      break;
+    case 3:
+      v.insert(v.begin(), items.begin(), items.end());
+      expected.insert(expected.begin(), items.begin(), items.end());
+      break;
+    case 4:
+      if (size > 0) {
+        std::size_t at = rng() % size, n = std::min(k, size - at);
+        v.erase(v.begin() + at, v.begin() + at + n);
+        expected.erase(expected.begin() + at, expected.begin() + at + n);
+      }
+      break;
+    case 5: {
+      std::size_t at = size ? rng() % size : 0;
+      v.insert(v.begin() + at, items.begin(), items.end());
+      expected.insert(expected.begin() + at, items.begin(), items.end());
+      break;
+    }
+    case 6:
+      if (size > 0 && size < 64) { // a range of itself, at the front or the back
+        std::size_t from = rng() % size, to = from + rng() % (size - from) + 1;
+        std::vector<std::string> copy(expected.begin() + from, expected.begin() + to);
+        bool front = rng() % 2;
+        v.insert(front ? v.begin() : v.end(), v.begin() + from, v.begin() + to);
+        expected.insert(front ? expected.begin() : expected.end(), copy.begin(), copy.end());
+        break;
+      }
+      [[fallthrough]];
+    default:
+      for (auto &item : items) {
+        v.push_back(item);
+        expected.push_back(item);
+      }
+    }
+    if (!same(v, expected) || v.size() != expected.size() || v.empty() != expected.empty())
+      return step;
+  }
+  return -1;
+}
+
+int main() {
+  check("random edits against std::deque", randomEdits(1), -1L);
+  check("random edits with another seed", randomEdits(2), -1L);
+
+  // 40 elements: 16 shifts reach the minimum slack but leave more elements than free slots, 4 more compact
+  OffsetVector<int> v;
+  for (int i = 0; i < 40; ++i)
+    v.push_back(i);
+  const int *base = v.data();
+  for (int i = 0; i < 16; ++i)
+    v.erase(v.begin());
+  check("shifts only move the head", v.data() == base + 16, true);
+  check("the front after 16 shifts", v.front(), 16);
+  for (int i = 0; i < 3; ++i)
+    v.erase(v.begin());
+  check("no compaction while the elements outnumber the free slots", v.data() == base + 19, true);
+  v.erase(v.begin());
+  check("compacted once the free slots equal the elements", v.data() == base, true);
+  check("compaction keeps the elements", v.front() == 20 && v.back() == 39 && v.size() == 20, true);
+
+  v.erase(v.begin(), v.begin() + 5);
+  v.insert(v.begin(), 100);
+  v.insert(v.begin(), 101);
+  check("unshift reuses the free slots", v.data() == base + 3, true);
+  std::vector<int> three{1, 2, 3};
+  v.insert(v.begin(), three.begin(), three.end());
+  check("a range fills the free slots exactly", v.data() == base, true);
+  check("and lands in order", v[0] == 1 && v[2] == 3 && v[3] == 101 && v[4] == 100 && v[5] == 25, true);
+  v.insert(v.begin(), 0);
+  check("unshift without free slots grows at the front", v.front() == 0 && v[1] == 1 && v.back() == 39, true);
+  check("growing leaves room for more", v.capacity() - v.size() >= 16, true);
+
+  OffsetVector<int> self{1, 2, 3};
+  self.insert(self.begin(), self.begin(), self.end());
+  self.insert(self.end(), self.begin() + 1, self.begin() + 3);
+  check("inserting a range of itself", same(self, std::vector<int>{1, 2, 3, 1, 2, 3, 2, 3}), true);
+  self.insert(self.begin(), self.back());
+  check("inserting one of its own elements", self.front(), 3);
+  self.erase(self.begin(), self.end());
+  check("erasing everything resets", self.empty() && self.size() == 0, true);
+
+  OffsetVector<bool> flags;
+  for (int i = 0; i < 40; ++i)
+    flags.push_back(i % 3 == 0);
+  for (int i = 0; i < 20; ++i)
+    flags.erase(flags.begin());
+  flags.insert(flags.begin(), true);
+  flags[1] = true; // a proxy reference, not bool &
+  check("bools across the compaction point", flags.size() == 21 && flags[0] && flags[1] && flags[2] && !flags[3], true);
+
+  // the same through Array, as shift/unshift
+  auto queue = $Array<int>::make();
+  for (int i = 0; i < 100; ++i)
+    queue->push(i);
+  int sum = 0;
+  for (int i = 0; i < 90; ++i)
+    sum += queue->shift();
+  check("Array shift", sum, 4005);
+  queue->unshift(queue->at(0));
+  queue->unshift(queue);
+  check("Array unshift of itself", show(queue), "[90, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 90, 90, 91, 92, 93, 94, "
+                                                "95, 96, 97, 98, 99]");
+  while (queue->length() > 0)
+    queue->shift();
+  check("Array shift to empty", queue->length(), std::size_t{0});
+  queue->unshift(7);
+  check("Array unshift after emptying", show(queue), "[7]");
+  return failures;
+}
@@ -0,0 +1,44 @@
+#!/bin/sh
+# Builds and runs the tests in tests/: the .tn programs with the compiler, and the C++ runtime tests against src/ with
+# the sanitizers on. Each one prints what it checked and exits with the number of failed checks.
+# TNC is the compiler to test (default dist/compiler), CXX and CXXFLAGS build the C++ tests.
+#   tests/run.sh
+set -e
+cd "$(dirname "$0")/.."
+TNC=$(realpath "${TNC:-dist/compiler}")
+CXX=${CXX:-clang++-20}
+CXXFLAGS=${CXXFLAGS:--std=c++20 -Wall -g -O1 -fsanitize=address,undefined -fno-sanitize-recover=undefined}
+
+# the compiler wants the sources and src/ in its working directory
+WORK=build/tests
+rm -rf $WORK
+mkdir -p $WORK
+cp tests/*.tn tests/*.cpp tests/*.hpp $WORK
+cp -r src $WORK
+cd $WORK
+
+failed=0
+for test in *.tn; do
+  name=${test%.tn}
+  if ! "$TNC" compile $test > /dev/null || ! "dist/$name"; then
+    echo "FAIL $name"
+    failed=1
+  fi
+done
+
+# the runtime is built once for all C++ tests, the collector's singletons outlive main so leaks aren't checked
+mkdir -p runtime
+runtime=""
+for source in src/core/*/*.cpp; do
+  object=runtime/$(basename ${source%.cpp}).o
+  $CXX $CXXFLAGS -Isrc -c $source -o $object
+  runtime="$runtime $object"
+done
+for test in *.cpp; do
+  name=${test%.cpp}
+  if ! $CXX $CXXFLAGS -Isrc $test $runtime -o dist/$name || ! ASAN_OPTIONS=detect_leaks=0 "dist/$name"; then
+    echo "FAIL $name"
+    failed=1
+  fi
+done
+exit $failed
@@ -0,0 +1,328 @@
+// Reads heap snapshots written by GC::snapshot (TN_HEAP_SNAPSHOT=<prefix> and SIGUSR2, see src/core/rt/README.md).
+// With one snapshot it prints per-type totals with retained sizes and the objects retaining the most memory; with two it
+// prints how the per-type totals changed between them.
+//   clang++-20 -std=c++20 -O2 tools/heapAnalyzer.cpp -o dist/heap-analyzer
+//   dist/heap-analyzer <snapshot.jsonl> [top objects, default 20]
+//   dist/heap-analyzer <before.jsonl> <after.jsonl>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+constexpr std::size_t NONE = -1;
+
+struct Node {
+  std::size_t type; // index into Snapshot::types
+  std::size_t size, refs;
+  std::vector<std::size_t> edges;
+  std::size_t arena = NONE; // the arena holding it, arena objects have no refs of their own
+};
+
+struct Snapshot {
+  std::vector<std::string> types;
+  std::vector<Node> nodes;
+  std::vector<std::vector<std::size_t>> arenas; // the objects of each arena
+};
+
+struct Totals {
+  std::size_t count = 0, shallow = 0, retained = 0;
+};
+
+std::size_t number(const std::string &line, const char *key) {
+  std::size_t i = line.find(key);
+  return i == std::string::npos ? 0 : std::strtoull(line.c_str() + i + std::char_traits<char>::length(key), nullptr, 10);
+}
+
+[[noreturn]] void malformed(const char *path, std::size_t line, const char *why) {
+  std::fprintf(stderr, "%s:%zu: %s\n", path, line, why);
+  std::exit(2);
+}
+
+Snapshot load(const char *path) {
+  std::ifstream in(path);
+  if (!in) {
+    std::fprintf(stderr, "can't read %s\n", path);
+    std::exit(2);
+  }
+  Snapshot snapshot;
+  std::unordered_map<std::string, std::size_t> typeIds;
+  std::size_t lineNumber = 0;
+  for (std::string line; std::getline(in, line);) {
+    ++lineNumber;
+    std::size_t t = line.find("\"type\":\"");
+    if (t == std::string::npos) { // the header
+      snapshot.arenas.resize(number(line, "\"arenas\":"));
+      continue;
+    }
+    t += 8;
+    std::size_t typeEnd = line.find('"', t);
+    std::size_t e = line.find("\"edges\":[");
+    if (typeEnd == std::string::npos || e == std::string::npos)
+      malformed(path, lineNumber, "expected a type and edges");
+    std::string type = line.substr(t, typeEnd - t);
+    auto [it, added] = typeIds.emplace(type, snapshot.types.size());
+    if (added)
+      snapshot.types.push_back(type);
+
+    Node node{it->second, number(line, "\"size\":"), number(line, "\"refs\":"), {}};
+    const char *p = line.c_str() + e + 9;
+    while (*p && *p != ']') {
+      char *end;
+      node.edges.push_back(std::strtoull(p, &end, 10));
+      if (end == p) // not a number, so it would never advance
+        malformed(path, lineNumber, "bad edge list");
+      p = *end == ',' ? end + 1 : end;
+    }
+    if (*p != ']')
+      malformed(path, lineNumber, "unterminated edge list");
+    if (number(line, "\"id\":") != snapshot.nodes.size())
+      malformed(path, lineNumber, "ids are out of order");
+    if (line.find("\"arena\":") != std::string::npos) {
+      node.arena = number(line, "\"arena\":");
+      if (node.arena >= snapshot.arenas.size())
+        malformed(path, lineNumber, "arena missing from the header");
+      snapshot.arenas[node.arena].push_back(snapshot.nodes.size());
+    }
+    snapshot.nodes.push_back(std::move(node));
+  }
+  // edges can point forward, so they are only checked once every node is in
+  for (const Node &node : snapshot.nodes)
+    for (std::size_t e : node.edges)
+      if (e >= snapshot.nodes.size()) {
+        std::fprintf(stderr, "%s: edge to #%zu, but there are only %zu objects\n", path, e, snapshot.nodes.size());
+        std::exit(2);
+      }
+  return snapshot;
+}
+
+// Dominators and retained sizes. Like the GC, an object counts as a root when it has more refs than edges pointing to
+// it, so something outside the heap (a variable) holds it. Arena objects are held by their arena instead, which gets a
+// node of its own after the objects: arena k is node n + k. The roots and the arenas hang off a virtual root, node top.
+struct Analysis {
+  const Snapshot &snapshot;
+  std::size_t n, top;
+  std::vector<std::size_t> order; // reverse postorder from the virtual root, which comes first
+  std::vector<std::size_t> rank;  // position in order, NONE if unreachable
+  std::vector<std::size_t> idom, retained;
+  std::vector<bool> root;
+  std::vector<std::size_t> roots; // the virtual root's edges
+
+  explicit Analysis(const Snapshot &snapshot)
+      : snapshot(snapshot), n(snapshot.nodes.size()), top(n + snapshot.arenas.size()), rank(top + 1, NONE),
+        idom(top + 1, NONE), retained(top + 1, 0), root(n, false) {
+    std::vector<std::size_t> inDegree(n, 0);
+    for (const Node &node : snapshot.nodes)
+      for (std::size_t e : node.edges)
+        ++inDegree[e];
+    for (std::size_t i = 0; i < n; ++i)
+      if ((root[i] = snapshot.nodes[i].arena == NONE && snapshot.nodes[i].refs > inDegree[i]))
+        roots.push_back(i);
+    for (std::size_t v = n; v < top; ++v)
+      roots.push_back(v);
+
+    postorder();
+    dominators();
+    for (std::size_t i = 0; i < n; ++i)
+      retained[i] = snapshot.nodes[i].size;
+    for (std::size_t r = order.size() - 1; r > 0; --r) // dominators come before what they dominate
+      retained[idom[order[r]]] += retained[order[r]];
+  }
+
+  const std::vector<std::size_t> &children(std::size_t v) const {
+    return v < n ? snapshot.nodes[v].edges : v < top ? snapshot.arenas[v - n] : roots;
+  }
+
+  void postorder() {
+    std::vector<std::pair<std::size_t, std::size_t>> stack{{top, 0}}; // node and next child
+    std::vector<bool> seen(top + 1, false);
+    seen[top] = true;
+    while (!stack.empty()) {
+      auto &[v, next] = stack.back();
+      const std::vector<std::size_t> &edges = children(v);
+      if (next < edges.size()) {
+        std::size_t w = edges[next++];
+        if (!seen[w]) {
+          seen[w] = true;
+          stack.emplace_back(w, 0);
+        }
+      } else {
+        order.push_back(v);
+        stack.pop_back();
+      }
+    }
+    std::reverse(order.begin(), order.end());
+    for (std::size_t r = 0; r < order.size(); ++r)
+      rank[order[r]] = r;
+  }
+
+  // Cooper, Harvey and Kennedy, "A Simple, Fast Dominance Algorithm"
+  void dominators() {
+    std::vector<std::vector<std::size_t>> preds(top + 1);
+    for (std::size_t v = 0; v < top; ++v)
+      if (rank[v] != NONE)
+        for (std::size_t e : children(v))
+          preds[e].push_back(v);
+    for (std::size_t v : roots)
+      preds[v].push_back(top);
+
+    auto intersect = [&](std::size_t a, std::size_t b) {
+      while (a != b) {
+        while (rank[a] > rank[b])
+          a = idom[a];
+        while (rank[b] > rank[a])
+          b = idom[b];
+      }
+      return a;
+    };
+    idom[top] = top;
+    for (bool changed = true; changed;) {
+      changed = false;
+      for (std::size_t r = 1; r < order.size(); ++r) {
+        std::size_t v = order[r], dom = NONE;
+        for (std::size_t p : preds[v])
+          if (idom[p] != NONE)
+            dom = dom == NONE ? p : intersect(p, dom);
+        if (dom != idom[v]) {
+          idom[v] = dom;
+          changed = true;
+        }
+      }
+    }
+  }
+
+  // An object's retained size only counts towards its type if no other object of that type dominates it, so that
+  // lists and trees aren't counted once per level.
+  std::vector<Totals> byType() const {
+    std::vector<Totals> totals(snapshot.types.size());
+    std::vector<std::vector<std::size_t>> tree(top + 1);
+    for (std::size_t r = 1; r < order.size(); ++r)
+      tree[idom[order[r]]].push_back(order[r]);
+
+    std::vector<std::size_t> inside(snapshot.types.size(), 0); // objects of each type on the current tree path
+    std::vector<std::pair<std::size_t, bool>> stack{{top, false}};
+    while (!stack.empty()) {
+      auto [v, leaving] = stack.back();
+      stack.pop_back();
+      if (v >= n) { // the virtual root or an arena
+        for (std::size_t c : tree[v])
+          stack.emplace_back(c, false);
+        continue;
+      }
+      std::size_t type = snapshot.nodes[v].type;
+      if (leaving) {
+        --inside[type];
+        continue;
+      }
+      if (inside[type]++ == 0)
+        totals[type].retained += retained[v];
+      stack.emplace_back(v, true);
+      for (std::size_t c : tree[v])
+        stack.emplace_back(c, false);
+    }
+    for (const Node &node : snapshot.nodes) {
+      ++totals[node.type].count;
+      totals[node.type].shallow += node.size;
+    }
+    return totals;
+  }
+};
+
+std::string describe(const Snapshot &snapshot, std::size_t v) {
+  if (v >= snapshot.nodes.size())
+    return "arena#" + std::to_string(v - snapshot.nodes.size());
+  return snapshot.types[snapshot.nodes[v].type] + "#" + std::to_string(v);
+}
+
+void analyze(const Snapshot &snapshot, std::size_t top) {
+  Analysis a(snapshot);
+  std::size_t unreachable = 0, garbage = 0, total = 0;
+  for (std::size_t i = 0; i < a.n; ++i) {
+    total += snapshot.nodes[i].size;
+    if (a.rank[i] == NONE) {
+      ++unreachable;
+      garbage += snapshot.nodes[i].size;
+    }
+  }
+  std::printf("%zu objects, %zu bytes, %zu roots, %zu arenas\n", a.n, total, a.roots.size() - snapshot.arenas.size(),
+              snapshot.arenas.size());
+  if (unreachable)
+    std::printf("%zu objects (%zu bytes) are only referenced from cycles, the next collection frees them\n", unreachable,
+                garbage);
+
+  std::vector<Totals> totals = a.byType();
+  std::vector<std::size_t> types(totals.size());
+  for (std::size_t i = 0; i < types.size(); ++i)
+    types[i] = i;
+  std::sort(types.begin(), types.end(), [&](auto x, auto y) { return totals[x].retained > totals[y].retained; });
+  std::printf("\n%-48s %10s %14s %14s\n", "type", "count", "shallow", "retained");
+  for (std::size_t t : types)
+    std::printf("%-48s %10zu %14zu %14zu\n", snapshot.types[t].c_str(), totals[t].count, totals[t].shallow,
+                totals[t].retained);
+
+  std::vector<std::size_t> objects;
+  for (std::size_t r = 1; r < a.order.size(); ++r)
+    objects.push_back(a.order[r]);
+  top = std::min(top, objects.size());
+  std::partial_sort(objects.begin(), objects.begin() + top, objects.end(),
+                    [&](auto x, auto y) { return a.retained[x] > a.retained[y]; });
+  std::printf("\n%-48s %14s %14s  held by\n", "object", "shallow", "retained");
+  for (std::size_t i = 0; i < top; ++i) {
+    std::size_t v = objects[i];
+    std::string chain;
+    std::size_t depth = 0;
+    for (std::size_t d = a.idom[v]; d != a.top; d = a.idom[d], ++depth)
+      if (depth == 4) {
+        chain += " <- ...";
+        break;
+      } else
+        chain += (chain.empty() ? "" : " <- ") + describe(snapshot, d);
+    std::printf("%-48s %14zu %14zu  %s\n", describe(snapshot, v).c_str(), v < a.n ? snapshot.nodes[v].size : 0,
+                a.retained[v], chain.empty() ? "(root)" : chain.c_str());
+  }
+}
+
+void diff(const Snapshot &before, const Snapshot &after) {
+  std::map<std::string, std::pair<Totals, Totals>> types;
+  auto add = [&](const Snapshot &snapshot, bool second) {
+    std::vector<Totals> totals = Analysis(snapshot).byType();
+    for (std::size_t t = 0; t < totals.size(); ++t)
+      (second ? types[snapshot.types[t]].second : types[snapshot.types[t]].first) = totals[t];
+  };
+  add(before, false);
+  add(after, true);
+
+  std::vector<std::pair<std::string, std::pair<Totals, Totals>>> sorted(types.begin(), types.end());
+  auto growth = [](auto &entry) {
+    return static_cast<long long>(entry.second.second.shallow) - static_cast<long long>(entry.second.first.shallow);
+  };
+  std::sort(sorted.begin(), sorted.end(), [&](auto &x, auto &y) { return growth(x) > growth(y); });
+  std::printf("%-48s %10s %14s %14s\n", "type", "count", "shallow", "retained");
+  for (auto &[name, t] : sorted) {
+    auto &[b, c] = t;
+    if (b.count == c.count && b.shallow == c.shallow && b.retained == c.retained)
+      continue;
+    std::printf("%-48s %+10lld %+14lld %+14lld\n", name.c_str(), static_cast<long long>(c.count - b.count),
+                static_cast<long long>(c.shallow - b.shallow), static_cast<long long>(c.retained - b.retained));
+  }
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <snapshot.jsonl> [top objects] | %s <before.jsonl> <after.jsonl>\n", argv[0],
+                 argv[0]);
+    return 2;
+  }
+  char *end;
+  std::size_t top = argc > 2 ? std::strtoull(argv[2], &end, 10) : 20;
+  if (argc > 2 && *end) // not a number, so a second snapshot
+    diff(load(argv[1]), load(argv[2]));
+  else
+    analyze(load(argv[1]), top);
+  return 0;
+}